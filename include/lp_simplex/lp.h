@@ -47,6 +47,36 @@ struct lp_Model {
 	struct optm_VariableBound *bounds;
 };
 
+/* Sparse linear programming model
+ *
+ * Nonzeros are appended as (row, column, value) triplets and compressed into
+ * columns (CSC) and rows (CSR) by `lp_simplex_sparse_compress`, where
+ * duplicates are summed and zeros dropped. The `coef` of every constraint
+ * is `NULL`.
+ */
+struct lp_SparseModel {
+	int m;			/* number of constraints */
+	int n;			/* number of variables */
+	int nnz;		/* number of triplets */
+	int mcap;		/* capacities of rows, columns and triplets */
+	int ncap;
+	int nnzcap;
+	double *objective;
+	struct optm_LinearConstraint *constraints;
+	struct optm_VariableBound *bounds;
+	int *trirow;		/* triplets */
+	int *tricol;
+	double *trival;
+	int compressed;		/* CSC and CSR match the triplets */
+	int nz;			/* number of compressed nonzeros */
+	int *colbeg;		/* CSC (length n + 1) */
+	int *rowidx;
+	double *colval;
+	int *rowbeg;		/* CSR (length m + 1) */
+	int *colidx;
+	double *rowval;
+};
+
 
 #ifdef __cpluscplus
 }
@@ -5,6 +5,7 @@
 #ifndef __lp_simplex_LP_H__
 #define __lp_simplex_LP_H__
 
+#include <stdio.h>
 #include "lp.h"
 #include "lp_simplex_utils.h"
 
@@ -33,6 +34,126 @@ extern "C" {
 #define lp_simplex_EXIT_FAILURE			-1
 #define lp_simplex_EXIT_SUCCESS			0
 
+#define lp_simplex_WEIGHTS_STEEPEST		1
+#define lp_simplex_WEIGHTS_DEVEX		2
+
+#define lp_simplex_BASIS_BASIC			0
+#define lp_simplex_BASIS_LOWER			1
+#define lp_simplex_BASIS_UPPER			2
+
+/* Index of the basis kept alongside `basis` for constant-time membership
+ */
+struct lp_simplex_BasisIndex {
+	int *bpos;		/* basis row of each column, -1 if nonbasic (length n) */
+	int *nonbasic;		/* nonbasic columns (length n) */
+	int nnonbasic;		/* number of nonbasic columns */
+};
+
+/* Bounds of the columns of a simplex table, handled by complementing:
+ * while `flip[j]` is set, column j holds x_j' = ub_j - x_j (x_j' = -x_j if free)
+ */
+struct lp_simplex_Bounds {
+	double *lb;		/* lower bound of every column, 0 or `NINF` if free (length n) */
+	double *ub;		/* upper bound of every column, `INF` if none (length n) */
+	int *flip;		/* complemented columns (length n) */
+	int nfree;		/* number of free columns */
+};
+
+/* Reference weights of the pricing rules "steepest" and "devex"
+ * (updated by `lp_simplex_pivot_core_ex` at each pivot)
+ */
+struct lp_simplex_Weights {
+	int rule;		/* `lp_simplex_WEIGHTS_STEEPEST` or `lp_simplex_WEIGHTS_DEVEX` */
+	double *gamma;		/* weight of every column (length n) */
+	double *work;		/* work array (length n) */
+};
+
+/* Reusable buffers of the solver (opaque)
+ *
+ * A workspace in `opts->workspace` keeps the simplex table and the other
+ * buffers of `lp_simplex_opt` (and the pool of threads) after the solve and
+ * grows them on demand, so that a solve no larger than an earlier one with
+ * the same workspace does no heap allocation. Presolve, scaling and the
+ * "revised" criterion still allocate their own buffers.
+ *
+ * A workspace serves one solve at a time. `lp_simplex_workspace_size` is the
+ * number of bytes it holds; `lp_simplex_workspace_create` returns `NULL` on
+ * allocation failure.
+ */
+struct lp_simplex_Workspace;
+
+struct lp_simplex_Workspace *lp_simplex_workspace_create(void);
+void lp_simplex_workspace_free(struct lp_simplex_Workspace *ws);
+size_t lp_simplex_workspace_size(const struct lp_simplex_Workspace *ws);
+
+/* Memory hooks of the library
+ *
+ * Every allocation of the library goes through `malloc_fn`, `realloc_fn`
+ * and `free_fn` (called with `ctx`); the buffers of a solve, whose table
+ * rows start on 64-byte boundaries, through `aligned_malloc_fn` and
+ * `aligned_free_fn` if both are set (otherwise an aligned block is carved
+ * out of `malloc_fn`). `lp_simplex_set_allocator(NULL)` restores `malloc`
+ * and `free`.
+ *
+ * The hooks are global: set them while no solve runs, and release memory
+ * with the hooks that allocated it.
+ */
+struct lp_simplex_Allocator {
+	void *(*malloc_fn)(void *ctx, size_t size);
+	void *(*realloc_fn)(void *ctx, void *ptr, size_t size);
+	void (*free_fn)(void *ctx, void *ptr);
+	void *(*aligned_malloc_fn)(void *ctx, size_t size, size_t align);	/* or `NULL` */
+	void (*aligned_free_fn)(void *ctx, void *ptr);				/* or `NULL` */
+	void *ctx;
+};
+
+void lp_simplex_set_allocator(const struct lp_simplex_Allocator *hooks);
+void lp_simplex_get_allocator(struct lp_simplex_Allocator *hooks);
+
+/* Bump allocator (opaque)
+ *
+ * `lp_simplex_arena_allocator` fills `hooks` with an allocator serving
+ * blocks from chunks of at least `chunk` bytes (0: 1 MiB) of `arena`, whose
+ * free does nothing. `lp_simplex_arena_reset` releases every block at once
+ * and keeps a single chunk as large as all chunks used so far, so that a
+ * repeated solve takes the same addresses. `lp_simplex_arena_used` is the
+ * number of bytes served since the last reset.
+ *
+ * An arena is not thread-safe, and the chunks come from `malloc`.
+ */
+struct lp_simplex_Arena;
+
+struct lp_simplex_Arena *lp_simplex_arena_create(const size_t chunk);
+void lp_simplex_arena_free(struct lp_simplex_Arena *arena);
+void lp_simplex_arena_reset(struct lp_simplex_Arena *arena);
+size_t lp_simplex_arena_used(const struct lp_simplex_Arena *arena);
+void lp_simplex_arena_allocator(struct lp_simplex_Arena *arena, struct lp_simplex_Allocator *hooks);
+
+/* Options of the simplex algorithm (a zero-initialized struct gives the defaults)
+ */
+struct lp_simplex_Options {
+	int nthreads;		/* threads sharing the row updates of a pivot (0 or 1: serial) */
+	int presolve;		/* reduce the LP before the simplex (see `lp_simplex_presolve`) */
+	int scaling;		/* scale rows and columns before the simplex (see `lp_simplex_scale`) */
+	int crash;		/* start phase 1 from a crash basis with fewer artificial variables */
+	struct lp_simplex_Workspace *workspace;	/* buffers reused across solves (or `NULL`) */
+};
+
+/* Persistent pool of worker threads (opaque)
+ *
+ * The pool is created once per solve and reused by every pivot; the caller
+ * of `lp_simplex_pool_run` takes part as worker 0. Without pthreads (or with
+ * `nthreads` <= 1) `lp_simplex_pool_create` returns `NULL`, which stands for
+ * the serial path everywhere a pool is taken.
+ */
+struct lp_simplex_Pool;
+
+struct lp_simplex_Pool *lp_simplex_pool_create(const int nthreads);
+void lp_simplex_pool_free(struct lp_simplex_Pool *pool);
+int lp_simplex_pool_size(const struct lp_simplex_Pool *pool);
+void lp_simplex_pool_run(struct lp_simplex_Pool *pool,
+			void (*task)(void *arg, const int id, const int nworkers), void *arg);
+
 
 /* Importing MPS file and get a `model`
  *
@@ -42,13 +163,99 @@ extern "C" {
  *		https://lpsolve.sourceforge.net/5.5/mps-format.htm
  *	2. the return of this function should be released by `lp_simplex_free`
  *	3. return `NULL` on failure
+ *	4. the file is parsed in one pass, by chunks, while the model grows
  */
 struct lp_Model* lp_simplex_read_mps(const char *file);
 
+/* Importing MPS data from an open stream `f` (a file, a pipe, `stdin`, ...),
+ * read to its end and not closed (see `lp_simplex_read_mps`)
+ */
+struct lp_Model *lp_simplex_read_mps_stream(FILE *f);
+
 /* Release the LP model
  */
 void lp_simplex_model_free(struct lp_Model *model);
 
+/* Importing MPS file and get a sparse `model` (see `lp_simplex_read_mps`)
+ *
+ * Note:
+ *	1. memory is proportional to the number of nonzeros
+ *	2. the return should be released by `lp_simplex_sparse_free`
+ *	3. return `NULL` on failure
+ */
+struct lp_SparseModel *lp_simplex_read_mps_sparse(const char *file);
+struct lp_SparseModel *lp_simplex_read_mps_sparse_stream(FILE *f);
+
+/* Builder of sparse LP models
+ *
+ * `lp_simplex_sparse_create` returns an empty model (or `NULL`).
+ * `lp_simplex_sparse_add_row` and `lp_simplex_sparse_add_col` append a
+ * constraint or a variable with its `nz` nonzeros (`idx` are column or row
+ * indices of existing variables or constraints), and return its index, or
+ * -1 on allocation failure. `lp_simplex_sparse_add_coef` appends one
+ * nonzero (duplicates are summed). `b_type` is one of `optm_BOUND_T_*`.
+ *
+ * Return of the others: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+struct lp_SparseModel *lp_simplex_sparse_create(void);
+void lp_simplex_sparse_free(struct lp_SparseModel *model);
+int lp_simplex_sparse_add_row(struct lp_SparseModel *model, const char *name, const int type, const double rhs,
+				const int nz, const int *idx, const double *val);
+int lp_simplex_sparse_add_col(struct lp_SparseModel *model, const char *name, const double obj,
+				const int b_type, const double lb, const double ub,
+				const int nz, const int *idx, const double *val);
+int lp_simplex_sparse_add_coef(struct lp_SparseModel *model, const int i, const int j, const double value);
+
+/* Compress the triplets into CSC and CSR (done by the solvers on demand)
+ */
+int lp_simplex_sparse_compress(struct lp_SparseModel *model);
+
+/* Dense copy of a sparse model (`NULL` on failure, release by `lp_simplex_model_free`)
+ */
+struct lp_Model *lp_simplex_sparse_to_dense(struct lp_SparseModel *model);
+
+/* Presolve of LP of general form (opaque)
+ *
+ * `lp_simplex_presolve` repeatedly removes empty and singleton rows, fixed
+ * and empty variables, singleton columns (as slacks or implied free
+ * variables), doubleton equations, dominated columns, and redundant or
+ * forcing rows found by the bounds on the row activities. It returns `NULL`
+ * with `*code` set to `lp_simplex_Infeasibility`, `lp_simplex_Unboundedness`
+ * or `lp_simplex_MemoryAllocError` if the LP is decided (or on failure).
+ *
+ * `lp_simplex_presolve_model` is the reduced LP (owned by the presolve),
+ * whose solution `x2` is mapped back to the original variables `x` by
+ * `lp_simplex_postsolve`. Ranged rows of the reduced LP come with an extra
+ * bounded column each, so its `n` may exceed the number of kept variables.
+ */
+struct lp_simplex_Presolve;
+
+struct lp_simplex_Presolve *lp_simplex_presolve(const double *objective,
+						const struct optm_LinearConstraint *constraints,
+						const struct optm_VariableBound *bounds,
+						const int m, const int n, int *code);
+const struct lp_Model *lp_simplex_presolve_model(const struct lp_simplex_Presolve *ps);
+void lp_simplex_postsolve(const struct lp_simplex_Presolve *ps, const double *x2, double *x);
+void lp_simplex_presolve_free(struct lp_simplex_Presolve *ps);
+
+/* Scale factors of the rows and columns of the constraints
+ *
+ * Iterated geometric mean scaling (the largest and smallest entries of every
+ * row and column are centered around 1) followed by equilibration (the
+ * largest entry of every row and column in [1, 2)). The factors are powers
+ * of 2, so that the scaled LP
+ *
+ *	min  (C c)'y
+ *	s.t. (R A C) y =[, >=, <=] R b
+ *		C^-1 lb <= y <= C^-1 ub
+ *
+ * with R = diag(rowscale), C = diag(colscale) and x = C y is exact.
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int lp_simplex_scale(const struct optm_LinearConstraint *constraints, const int m, const int n,
+			double *rowscale, double *colscale);
+
 /* Simplex algorithm for solving LP of general form
  *
  *	min  c'x
@@ -70,6 +277,11 @@ void lp_simplex_model_free(struct lp_Model *model);
  *				1) "dantzig"	Dantzig's original rule
  *				2) "bland"	Bland's rule
  *				3) "pan97"	Pan (1997)
+ *				4) "revised"	revised simplex on LU-factored basis
+ *				5) "steepest"	steepest edge
+ *				6) "devex"	Devex (Forrest and Goldfarb, 1992)
+ *				7) "partial"	partial pricing on rotating segments
+ *				8) "multiple"	multiple pricing on a candidate list
  *	niter		iteration limit
  *	x		array of solutions (length = n)
  *	value		optimal value of the objective
@@ -82,6 +294,32 @@ int lp_simplex(const double *objective, const struct optm_LinearConstraint *cons
 		const int m, const int n, const char *criteria, const int niter,
 		double *x, double *value, int *code);
 
+/* Simplex algorithm for solving LP of general form with options
+ * (`lp_simplex` with `opts`, or default options if `opts` is `NULL`)
+ *
+ * With `opts->nthreads` > 1 the row updates of every pivot are split across
+ * a pool of threads created once for the solve. Each row is updated by one
+ * thread with the same operations as the serial path, so the solution and
+ * the pivot sequence are identical to the serial ones.
+ *
+ * With `opts->presolve` the reduced LP of `lp_simplex_presolve` is solved
+ * instead, and its solution is mapped back by `lp_simplex_postsolve`.
+ *
+ * With `opts->scaling` the (reduced) LP is scaled by `lp_simplex_scale`
+ * before the simplex table is built, and the solution is unscaled.
+ *
+ * With `opts->crash` phase 1 starts from a crash basis, in which real
+ * columns replace as many artificial variables as feasible pivots allow.
+ *
+ * The criteria "revised" honors presolve and scaling only: `opts->nthreads`,
+ * `opts->crash` and `opts->workspace` have no effect on it.
+ */
+int lp_simplex_opt(const double *objective, const struct optm_LinearConstraint *constraints,
+		const struct optm_VariableBound *bounds,
+		const int m, const int n, const char *criteria, const int niter,
+		const struct lp_simplex_Options *opts,
+		double *x, double *value, int *code);
+
 /* Simplex algorithm for solving LP of general form
  * (Wrapper of `lp_simplex_fmin_lp_simplex_full` by taking `lp_simplex_Model_LP` as input)
  *
@@ -96,6 +334,41 @@ int lp_simplex(const double *objective, const struct optm_LinearConstraint *cons
 int lp_simplex_wrp(const struct lp_Model *model, const char *criteria, const int niter,
 			double *x, double *value, int *code);
 
+/* Solve independent LP models in parallel
+ *
+ * The `nmodel` models are shared by `nthreads` workers of a pool: every
+ * worker starts with an equal range of models and, once done, steals the
+ * back half of the range of another worker. Each worker solves its models
+ * by `lp_simplex_opt` with `opts` (or the defaults) on its own workspace,
+ * serially (`opts->nthreads` and `opts->workspace` are ignored).
+ *
+ * Outputs of model k: solution `x[k]` (length = models[k]->n), optimal value
+ * `value[k]` and error code `code[k]`. Allocator hooks (see
+ * `lp_simplex_set_allocator`) are called from every worker and should be
+ * thread-safe when `nthreads` > 1.
+ *
+ * Return: `EXIT_SUCCESS` if every model is solved, otherwise `EXIT_FAILURE`
+ */
+int lp_simplex_batch(struct lp_Model *const *models, const int nmodel, const char *criteria,
+			const int niter, const struct lp_simplex_Options *opts, const int nthreads,
+			double **x, double *value, int *code);
+
+/* Simplex algorithm for solving a sparse LP model
+ *
+ * With the criteria "revised" the compressed columns are passed to
+ * `lp_simplex_rev` as they are, so that the constraint matrix is never
+ * stored dense. Other criteria build the (dense) simplex table from a dense
+ * copy of the model, and so does "revised" when `opts` asks for presolve or
+ * scaling (both work on the dense copy).
+ *
+ * Parameters: same as `lp_simplex_opt`
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int lp_simplex_sparse(struct lp_SparseModel *model, const char *criteria, const int niter,
+			const struct lp_simplex_Options *opts,
+			double *x, double *value, int *code);
+
 /* Simplex algorithm for solving LP of standard form
  *
  *	min  c'x
@@ -114,6 +387,11 @@ int lp_simplex_wrp(const struct lp_Model *model, const char *criteria, const int
  *				1) "dantzig"	Dantzig's original rule
  *				2) "bland"	Bland's rule
  *				3) "pan97"	Pan (1997)
+ *				4) "revised"	revised simplex on LU-factored basis
+ *				5) "steepest"	steepest edge
+ *				6) "devex"	Devex (Forrest and Goldfarb, 1992)
+ *				7) "partial"	partial pricing on rotating segments
+ *				8) "multiple"	multiple pricing on a candidate list
  *	x		array of solutions (length = n)
  *	value		optimal value of the objective
  *	code		error code (see basic.h)
@@ -125,6 +403,244 @@ int lp_simplex_std(const double *objective, const struct optm_LinearConstraint *
 			const int m, const int n, const char *criteria, const int niter,
 			double *x, double *value, int *code);
 
+/* Simplex algorithm for solving LP of standard form with bounds
+ *
+ *	min  c'x
+ *	s.t. Ai x =(, >=, <=) bi, i = 1, ..., m
+ *		lb <= x <= ub
+ *
+ * Parameters: same as `lp_simplex_std`, and
+ *	lb		lower bounds of variables (length = n), each being 0 or
+ *			`NINF` (free variable, whose upper bound must be `INF`),
+ *			or `NULL` indicating "x >= 0"
+ *	ub		upper bounds of variables (length = n, `INF` allowed),
+ *			or `NULL` indicating no upper bound
+ *	opts		options (see `lp_simplex_Options`), or `NULL` for defaults
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int lp_simplex_std_bnd(const double *objective, const struct optm_LinearConstraint *constraints,
+			const double *lb, const double *ub, const int m, const int n, const char *criteria, const int niter,
+			const struct lp_simplex_Options *opts,
+			double *x, double *value, int *code);
+
+/* Revised simplex algorithm for solving LP with bounded variables
+ *
+ * The constraint matrix is kept in compressed columns and the basis is
+ * factorized by LU (LAPACK) and updated by eta columns at each pivot, so
+ * memory scales with the nonzeros of A and the factors rather than with
+ * a dense simplex table. Variable bounds are handled natively.
+ *
+ * Parameters: same as `lp_simplex`
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int lp_simplex_rev(const double *objective, const struct optm_LinearConstraint *constraints,
+			const struct optm_VariableBound *bounds,
+			const int m, const int n, const int niter,
+			double *x, double *value, int *code);
+
+/* Handle of the revised simplex algorithm keeping its factorized basis
+ * between solves (opaque)
+ */
+struct lp_simplex_Solver;
+
+/* To create in heap (need to be released by `lp_simplex_solver_free`) a solver
+ *
+ * Parameters: same as `lp_simplex` (the data are copied)
+ *
+ * Return: the solver, or `NULL` if memory allocation fails
+ */
+struct lp_simplex_Solver *lp_simplex_solver_create(const double *objective,
+						const struct optm_LinearConstraint *constraints,
+						const struct optm_VariableBound *bounds,
+						const int m, const int n);
+
+/* Create a solver from a sparse model (compressed on demand)
+ */
+struct lp_simplex_Solver *lp_simplex_solver_create_sparse(struct lp_SparseModel *model);
+
+void lp_simplex_solver_free(struct lp_simplex_Solver *solver);
+
+/* Change the right hand side of constraint `i` */
+void lp_simplex_solver_set_rhs(struct lp_simplex_Solver *solver, const int i, const double rhs);
+
+/* Change the objective coefficient of variable `j` */
+void lp_simplex_solver_set_objective(struct lp_simplex_Solver *solver, const int j, const double c);
+
+/* Change the bounds of variable `j` to [lb, ub] (infinite values allowed;
+ * `lp_simplex_solver_solve` reports infeasibility while lb > ub) */
+void lp_simplex_solver_set_bounds(struct lp_simplex_Solver *solver, const int j, const double lb, const double ub);
+
+/* Change the coefficient of variable `j` in constraint `i`
+ *
+ * Return: `EXIT_SUCCESS`, or `EXIT_FAILURE` if memory allocation fails
+ */
+int lp_simplex_solver_set_coef(struct lp_simplex_Solver *solver, const int i, const int j, const double a);
+
+/* Add or delete constraints and variables
+ *
+ * New constraints get the indices m, ..., m + nrow - 1 (coefficients of the
+ * n variables in `constraints[k].coef`), and new variables n, ..., n + ncol
+ * - 1 with the objective coefficients `objective`, the bounds `bounds` (or
+ * `NULL`, as in `lp_simplex`) and the coefficients of variable n + k in
+ * `coef[k * m]`, ..., `coef[k * m + m - 1]`. Deleting constraints `rows`
+ * (or variables `cols`) renumbers the remaining ones in the same order.
+ *
+ * The basis of the last solve is kept: the logical variables of new rows
+ * are basic and its factorization is extended, so the next solve goes on by
+ * the dual simplex algorithm; new variables are nonbasic at the bound
+ * closest to zero, so the next solve goes on by the primal simplex
+ * algorithm. A deleted basic variable (or nonbasic row) is first pivoted
+ * out of (into) the basis.
+ *
+ * Return: `EXIT_SUCCESS`, or `EXIT_FAILURE` if memory allocation fails
+ */
+int lp_simplex_solver_add_rows(struct lp_simplex_Solver *solver, const int nrow,
+				const struct optm_LinearConstraint *constraints);
+int lp_simplex_solver_add_cols(struct lp_simplex_Solver *solver, const int ncol, const double *objective,
+				const double *coef, const struct optm_VariableBound *bounds);
+int lp_simplex_solver_del_rows(struct lp_simplex_Solver *solver, const int nrow, const int *rows);
+int lp_simplex_solver_del_cols(struct lp_simplex_Solver *solver, const int ncol, const int *cols);
+
+/* Solve the LP held by `solver`
+ *
+ * After a successful solve, the optimal basis is kept and the next solve
+ * re-optimizes from it: by the dual simplex algorithm (dual steepest edge
+ * pricing) if only `rhs` or bounds have changed, by the primal simplex
+ * algorithm if only the objective has changed, falling back to the primal
+ * simplex algorithm from scratch if the basis can not be reused.
+ *
+ * Parameters:
+ *	niter		iteration limit
+ *	x		array of solutions (length = n)
+ *	value		optimal value of the objective
+ *	code		error code (see basic.h)
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int lp_simplex_solver_solve(struct lp_simplex_Solver *solver, const int niter,
+				double *x, double *value, int *code);
+
+/* Basis of the solver (warm start)
+ *
+ * The status of every column (`cstat`, length n) and row (`rstat`, length
+ * m) is `lp_simplex_BASIS_BASIC`, or `lp_simplex_BASIS_LOWER` or
+ * `lp_simplex_BASIS_UPPER` for a nonbasic variable, or row activity, at its
+ * lower or upper bound.
+ *
+ * `lp_simplex_solver_get_basis` returns the basis of the last successful
+ * solve (`EXIT_FAILURE` if there is none). `lp_simplex_solver_set_basis`
+ * makes the next solve start from the given basis, which needs m basic
+ * variables (`EXIT_FAILURE` otherwise); if it is singular, or neither
+ * primal nor dual feasible, the solve falls back to phase 1.
+ */
+int lp_simplex_solver_get_basis(const struct lp_simplex_Solver *solver, int *cstat, int *rstat);
+int lp_simplex_solver_set_basis(struct lp_simplex_Solver *solver, const int *cstat, const int *rstat);
+
+/* Sensitivity of an optimal solution (any member may be `NULL`)
+ *
+ * `dual` (length m) is the change of the optimal value per unit change of
+ * every `rhs`, and `redcost` (length n) the reduced cost c_j - y^T A_j of
+ * every variable. The current basis stays optimal while the objective
+ * coefficient j alone is in [`objlo[j]`, `objup[j]`], and feasible while the
+ * `rhs` of constraint i alone is in [`rhslo[i]`, `rhsup[i]`] (`INF` and
+ * `NINF` for no limit).
+ */
+struct lp_simplex_Ranging {
+	double *dual;
+	double *redcost;
+	double *objlo;
+	double *objup;
+	double *rhslo;
+	double *rhsup;
+};
+
+/* Sensitivity of the last successful solve of `solver`, read from its
+ * factorized optimal basis (`EXIT_FAILURE` if there is none)
+ */
+int lp_simplex_solver_ranging(struct lp_simplex_Solver *solver, struct lp_simplex_Ranging *rg);
+
+/* Solve the LP by the revised simplex algorithm (see `lp_simplex_rev`) and
+ * get its sensitivity in `rg`
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int lp_simplex_ranging(const double *objective, const struct optm_LinearConstraint *constraints,
+			const struct optm_VariableBound *bounds, const int m, const int n, const int niter,
+			double *x, double *value, int *code, struct lp_simplex_Ranging *rg);
+
+/* Parametric simplex algorithm: the LP with rhs b + lam * `drhs` (or the
+ * objective c + lam * `dobj`, the other being `NULL`) for lam in [0, lmax]
+ *
+ * From the optimal basis at lam = 0, the basis is kept until a basic
+ * variable reaches its bound (or a reduced cost changes sign), where one
+ * dual (or primal) simplex pivot gives the basis of the next piece. The
+ * optimal value is linear between consecutive breakpoints.
+ *
+ * Breakpoint k is `lambda[k]` (increasing, from 0 to the end of the sweep)
+ * with its optimal value `value[k]` and, if `cstat` and `rstat` are not
+ * `NULL`, the basis optimal from `lambda[k]` to `lambda[k + 1]` in
+ * `cstat[k * n]`, ... and `rstat[k * m]`, ... (see
+ * `lp_simplex_solver_get_basis`). `*nbp` breakpoints are written (at most
+ * `maxbp`), and `code` tells where the sweep ended:
+ *	lp_simplex_Success		at lmax
+ *	lp_simplex_Infeasibility	the LP is infeasible beyond the last breakpoint
+ *	lp_simplex_Unboundedness	the LP is unbounded beyond the last breakpoint
+ *	lp_simplex_ExceedIterLimit	`maxbp` or `niter` is reached
+ *
+ * The solver keeps rhs b (or objective c) and the last basis, from which
+ * the next solve starts.
+ *
+ * Return: `EXIT_SUCCESS`, or `EXIT_FAILURE` if the LP at lam = 0 is not solved
+ */
+int lp_simplex_solver_parametric(struct lp_simplex_Solver *solver, const double *drhs, const double *dobj,
+				const double lmax, const int maxbp, const int niter,
+				double *lambda, double *value, int *cstat, int *rstat, int *nbp, int *code);
+
+/* Solve scenarios of one constraint matrix
+ *
+ * Scenario k has the right hand sides `rhs[k * m]`, ..., `rhs[k * m + m - 1]`
+ * (or those of `constraints` if `rhs` is `NULL`) and the objective
+ * `objectives[k * n]`, ..., `objectives[k * n + n - 1]` (or `objective` if
+ * `objectives` is `NULL`). All scenarios share one solver handle, so A is
+ * compressed and the bounds are converted once, and every scenario is
+ * re-optimized from the optimal basis of the last solved one (see
+ * `lp_simplex_solver_solve`): dual simplex for new `rhs`, primal simplex
+ * for a new objective.
+ *
+ * Outputs of scenario k: solution `x[k * n]`, ..., `x[k * n + n - 1]`,
+ * optimal value `value[k]` and error code `code[k]`.
+ *
+ * Return: `EXIT_SUCCESS` if every scenario is solved, otherwise `EXIT_FAILURE`
+ */
+int lp_simplex_multi(const double *objective, const struct optm_LinearConstraint *constraints,
+			const struct optm_VariableBound *bounds, const int m, const int n,
+			const int nscen, const double *rhs, const double *objectives, const int niter,
+			double *x, double *value, int *code);
+
+/* Basis files (MPS basis format)
+ *
+ * The file lists "XU"/"XL" (basic column, and nonbasic row at its upper or
+ * lower bound), "UL" (nonbasic column at upper bound) and "LL" (nonbasic
+ * column at lower bound) records; other rows are basic and other columns
+ * at lower bound. Names come from `constraints` and `bounds` (or are "R1",
+ * "R2", ... and "C1", "C2", ... if empty or `bounds` is `NULL`).
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int lp_simplex_write_basis(const char *file, const struct optm_LinearConstraint *constraints,
+			const struct optm_VariableBound *bounds, const int m, const int n,
+			const int *cstat, const int *rstat);
+int lp_simplex_read_basis(const char *file, const struct optm_LinearConstraint *constraints,
+			const struct optm_VariableBound *bounds, const int m, const int n,
+			int *cstat, int *rstat);
+
+/* Build the index of `basis` (length m) over columns 0, ..., n - 1
+ * (`idx->bpos` and `idx->nonbasic` of length n should be allocated)
+ */
+void lp_simplex_basis_index(struct lp_simplex_BasisIndex *idx, const int *basis, const int m, const int n);
+
 /* Simplex algorithm for solving LP of basic representation
  *
  * Return
@@ -132,13 +648,41 @@ int lp_simplex_std(const double *objective, const struct optm_LinearConstraint *
  *	1: current BSF is optimal
  *	2: LP is unbounded
  *	3: LP is circled more than accepted times (indicating for degeneracy)
+ *	4: memory allocation error
  *	9: numerical precision error
  */
 int lp_simplex_bsc(int *epoch, double *table, const int ldtable, int *basis,
 			const int m, const int n, const int nreal,
 			const char *criteria, const int niter);
 
+/* Extended `lp_simplex_bsc`
+ *
+ * The index of basis `idx` is updated with `basis` at each pivot; if it is
+ * `NULL`, a temporary index is built from `basis`.
+ *
+ * Bounds `bd` (or `NULL`) are handled in the ratio test: a variable
+ * reaching its upper bound is complemented instead of adding a constraint row.
+ * Free variables enter in either direction and never leave the basis.
+ *
+ * The row updates of each pivot are shared by the workers of `pool` (or
+ * `NULL` for the serial path).
+ *
+ * Work arrays of the pricing rules are taken from `ws` (or allocated by this
+ * call if `NULL`).
+ *
+ * Return: same as `lp_simplex_bsc`
+ */
+int lp_simplex_bsc_ex(int *epoch, double *table, const int ldtable, int *basis,
+			struct lp_simplex_BasisIndex *idx, struct lp_simplex_Bounds *bd,
+			const int m, const int n, const int nreal,
+			const char *criteria, const int niter, struct lp_simplex_Pool *pool,
+			struct lp_simplex_Workspace *ws);
+
 /* Key subroutine of pivoting
+ *
+ * The three rules run as one fused, cache-tiled SIMD kernel (see
+ * `lp_simplex_kernel_rank1`), or as one BLAS call per row on a CPU without
+ * SIMD variant.
  *
  * Parameter:
  * 	table	simplex table
@@ -155,6 +699,17 @@ void lp_simplex_pivot_core(double *table, const int ldtable,
 			const int m, const int n, const int p, const int q,
 			const int rule1, const int rule2, const int rule3);
 
+/* Extended `lp_simplex_pivot_core`
+ *
+ * Parameter: same as `lp_simplex_pivot_core`, and
+ *	wt	reference weights updated with the pivot (or `NULL`)
+ *	pool	worker pool sharing the rows of rule2 and rule3 (or `NULL` for serial)
+ */
+void lp_simplex_pivot_core_ex(double *table, const int ldtable,
+			const int m, const int n, const int p, const int q,
+			const int rule1, const int rule2, const int rule3,
+			struct lp_simplex_Weights *wt, struct lp_simplex_Pool *pool);
+
 #ifdef __cpluscplus
 }
 #endif /* __cpluscplus */
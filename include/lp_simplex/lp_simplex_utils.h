@@ -15,6 +15,64 @@ extern "C" {
 void lp_simplex_linalg_daxpy(int n, double a, double *x, int incx, double *y, int incy);
 void lp_simplex_linalg_dscal(int n, double x, double *arr, int inc);
 void lp_simplex_linalg_dlarfg(int n, double *alpha, double *x, int incx, double *tau);
+int lp_simplex_linalg_dgetrf(int m, int n, double *a, int lda, int *ipiv);
+void lp_simplex_linalg_dgetrs(char trans, int n, int nrhs, double *a, int lda, int *ipiv, double *b, int ldb);
+
+/* SIMD kernels (scalar, SSE2, AVX2 or AVX-512, chosen once from the CPU;
+ * BLAS `dscal` and `daxpy` take over the row operations when no SIMD
+ * variant is available)
+ *
+ * `lp_simplex_kernel_rank1` updates the rows [begin, end) of a table except
+ * row p by row_i -= table[i][q] * row_p, in column tiles with the tile of
+ * column q last. `lp_simplex_kernel_argmax_at` returns the first k with the
+ * largest x[idx[k]] above `floor` (or `len` if none). `lp_simplex_kernel_use`
+ * forces "scalar", "blas", "sse2", "avx2" or "avx512" and fails if the CPU
+ * (or the build) lacks it.
+ */
+const char *lp_simplex_kernel_isa(void);
+int lp_simplex_kernel_use(const char *isa);
+void lp_simplex_kernel_scale(double *row, const double a, const int len);
+void lp_simplex_kernel_rank1(double *table, const int ldtable, const int ncol,
+				const int p, const int q, const int begin, const int end);
+int lp_simplex_kernel_any_above(const double *x, const double tol, const int len);
+int lp_simplex_kernel_argmax_at(const double *x, const int *idx, const double floor, const int len);
+int lp_simplex_kernel_argmaxabs(const double *x, const int len);
+double lp_simplex_kernel_maxabs(const double *x, const int len);
+double lp_simplex_kernel_maxabs_gap(const double *x, const double *y, const int len);
+
+/* Slots of the buffers kept by a solver workspace */
+#define __lp_simplex_WS_OBJ2__		0	/* `lp_simplex_opt`: standard form */
+#define __lp_simplex_WS_X2__		1
+#define __lp_simplex_WS_BND2__		2
+#define __lp_simplex_WS_COEF2__		3
+#define __lp_simplex_WS_CONS2__		4
+#define __lp_simplex_WS_TABLE__		5	/* `lp_simplex_std_bnd`: simplex table */
+#define __lp_simplex_WS_BASIS__		6
+#define __lp_simplex_WS_BPOS__		7
+#define __lp_simplex_WS_CONSTYPES__	8
+#define __lp_simplex_WS_BOUNDS__	9
+#define __lp_simplex_WS_FLIP__		10
+#define __lp_simplex_WS_INDEX__		11	/* `lp_simplex_bsc`: pricing */
+#define __lp_simplex_WS_GAMMA__		12
+#define __lp_simplex_WS_PAN97I__	13
+#define __lp_simplex_WS_PAN97D__	14
+#define __lp_simplex_WS_NSLOT__		15
+
+/* Buffers of a solve taken from workspace `ws`
+ *
+ * Buffers start on `__lp_simplex_ALIGN__` bytes. With `ws` = `NULL` these
+ * fall back to `lp_simplex_malloc_aligned`, `lp_simplex_free_aligned` and a
+ * pool of the solve. Otherwise the buffer of `slot` is grown to `size` bytes
+ * (its content is not kept) and stays owned by `ws`, as does the pool, so
+ * that the release functions do nothing.
+ */
+struct lp_simplex_Workspace;
+struct lp_simplex_Pool;
+
+void *lp_simplex_ws_alloc(struct lp_simplex_Workspace *ws, const int slot, size_t size);
+void lp_simplex_ws_free(struct lp_simplex_Workspace *ws, void *ptr);
+struct lp_simplex_Pool *lp_simplex_ws_pool(struct lp_simplex_Workspace *ws, const int nthreads);
+void lp_simplex_ws_pool_release(struct lp_simplex_Workspace *ws, struct lp_simplex_Pool *pool);
 
 int is_in_arri(const int idx, const int *idxset, const int len);
 int maxabs_arri(const int *arr, const int len, const int inc);
@@ -29,8 +87,14 @@ void lp_simplex_prt_arrd(const double *arr, const int len, const int inc, const
 void lp_simplex_prt_arrld(const long double *arr, const int len, const int inc, const int sci);
 void lp_simplex_prt_matd(const double *mat, const int ld, const int nrow, const int ncol);
 
+/* Alignment (bytes) of the rows of a simplex table */
+#define __lp_simplex_ALIGN__		64
+
 void *lp_simplex_malloc(size_t size);
+void *lp_simplex_realloc(void *ptr, size_t size);
 void lp_simplex_free(void *ptr);
+void *lp_simplex_malloc_aligned(size_t size, size_t align);
+void lp_simplex_free_aligned(void *ptr);
 
 void *lp_simplex_memset(void *str, int c, size_t n);
 void *lp_simplex_memcpy(void *dest, const void *src, size_t n);
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <stdlib.h>
+#include <lp_simplex/lp_simplex_utils.h>
+#include <lp_simplex/lp_simplex.h>
+
+/* Default size of a chunk (bytes) */
+#define __lp_simplex_ARENA_CHUNK__		(1UL << 20)
+
+/* Alignment of every block, which also holds the size of the block before it */
+#define __lp_simplex_ARENA_ALIGN__		16
+
+/* Blocks are served from the front chunk; a block that does not fit opens a
+ * new chunk in front of the others
+ */
+struct arena_Chunk {
+	struct arena_Chunk *next;
+	size_t size;		/* bytes of `data` */
+	size_t used;
+	double data[1];		/* aligned start of the data */
+};
+
+struct lp_simplex_Arena {
+	struct arena_Chunk *head;
+	size_t chunk;		/* least size of a new chunk */
+	size_t used;		/* bytes served since the last reset */
+};
+
+static struct arena_Chunk *arena_chunk(const size_t size, struct arena_Chunk *next)
+{
+	struct arena_Chunk *c;
+
+	c = (struct arena_Chunk *)malloc(sizeof(struct arena_Chunk) + size);
+	if (c == NULL)
+		return NULL;
+	c->next = next;
+	c->size = size;
+	c->used = 0;
+	return c;
+}
+
+static void arena_release(struct arena_Chunk *c)
+{
+	struct arena_Chunk *next;
+
+	for (; c; c = next) {
+		next = c->next;
+		free(c);
+	}
+}
+
+/* Block of `size` bytes starting on `align` bytes, with its size kept right
+ * before it (for realloc)
+ */
+static void *arena_alloc(struct lp_simplex_Arena *arena, const size_t size, size_t align)
+{
+	struct arena_Chunk *c = arena->head;
+	char *base, *ptr;
+	size_t need;
+
+	if (align < __lp_simplex_ARENA_ALIGN__)
+		align = __lp_simplex_ARENA_ALIGN__;
+	if (c) {
+		base = (char *)c->data;
+		ptr = base + c->used + sizeof(size_t);
+		ptr += (align - (size_t)ptr % align) % align;
+		if ((size_t)(ptr - base) + size <= c->size)
+			goto DONE;
+	}
+	need = size + align + sizeof(size_t);
+	c = arena_chunk(need > arena->chunk ? need : arena->chunk, arena->head);
+	if (c == NULL)
+		return NULL;
+	arena->head = c;
+	base = (char *)c->data;
+	ptr = base + sizeof(size_t);
+	ptr += (align - (size_t)ptr % align) % align;
+DONE:
+	((size_t *)ptr)[-1] = size;
+	c->used = (size_t)(ptr - base) + size;
+	arena->used += size;
+	return ptr;
+}
+
+static void *arena_malloc(void *ctx, size_t size)
+{
+	return arena_alloc((struct lp_simplex_Arena *)ctx, size, __lp_simplex_ARENA_ALIGN__);
+}
+
+static void *arena_malloc_aligned(void *ctx, size_t size, size_t align)
+{
+	return arena_alloc((struct lp_simplex_Arena *)ctx, size, align);
+}
+
+static void arena_free(void *ctx, void *ptr)
+{
+	(void) ctx;
+	(void) ptr;
+}
+
+static void *arena_realloc(void *ctx, void *ptr, size_t size)
+{
+	void *ptr2;
+	size_t size0;
+
+	if (ptr == NULL)
+		return arena_malloc(ctx, size);
+	size0 = ((size_t *)ptr)[-1];
+	if (size <= size0)
+		return ptr;
+	ptr2 = arena_malloc(ctx, size);
+	if (ptr2 != NULL)
+		lp_simplex_memcpy(ptr2, ptr, size0);
+	return ptr2;
+}
+
+struct lp_simplex_Arena *lp_simplex_arena_create(const size_t chunk)
+{
+	struct lp_simplex_Arena *arena;
+
+	arena = (struct lp_simplex_Arena *)malloc(sizeof(struct lp_simplex_Arena));
+	if (arena == NULL)
+		return NULL;
+	arena->head = NULL;
+	arena->chunk = chunk ? chunk : __lp_simplex_ARENA_CHUNK__;
+	arena->used = 0;
+	return arena;
+}
+
+void lp_simplex_arena_free(struct lp_simplex_Arena *arena)
+{
+	if (arena == NULL)
+		return;
+	arena_release(arena->head);
+	free(arena);
+}
+
+void lp_simplex_arena_reset(struct lp_simplex_Arena *arena)
+{
+	struct arena_Chunk *c;
+	size_t size = 0;
+
+	assert(arena != NULL);
+	arena->used = 0;
+	if (arena->head == NULL)
+		return;
+	if (arena->head->next == NULL) {
+		arena->head->used = 0;
+		return;
+	}
+	for (c = arena->head; c; c = c->next)
+		size += c->size;
+	arena_release(arena->head);
+	arena->head = arena_chunk(size, NULL);  /* `NULL`: chunks are opened again on demand */
+}
+
+size_t lp_simplex_arena_used(const struct lp_simplex_Arena *arena)
+{
+	return arena->used;
+}
+
+void lp_simplex_arena_allocator(struct lp_simplex_Arena *arena, struct lp_simplex_Allocator *hooks)
+{
+	assert(arena != NULL);
+	assert(hooks != NULL);
+	hooks->malloc_fn = arena_malloc;
+	hooks->realloc_fn = arena_realloc;
+	hooks->free_fn = arena_free;
+	hooks->aligned_malloc_fn = arena_malloc_aligned;
+	hooks->aligned_free_fn = arena_free;
+	hooks->ctx = arena;
+}
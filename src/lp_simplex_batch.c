@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#ifdef USE_PTHREAD
+#define _POSIX_C_SOURCE 200112L
+#include <pthread.h>
+#endif
+#include <lp_simplex/lp_simplex_utils.h>
+#include <lp_simplex/lp_simplex.h>
+
+/* Models [lo, hi) left to a worker: the owner takes them from the front and
+ * an idle worker steals the back half
+ */
+struct batch_Deque {
+	int lo;
+	int hi;
+#ifdef USE_PTHREAD
+	pthread_mutex_t lock;
+#endif
+};
+
+struct batch_Job {
+	struct lp_Model *const *models;
+	const char *criteria;
+	int niter;
+	const struct lp_simplex_Options *opts;
+	double **x;
+	double *value;
+	int *code;
+	struct batch_Deque *deques;
+};
+
+static void batch_lock(struct batch_Deque *d)
+{
+#ifdef USE_PTHREAD
+	pthread_mutex_lock(&d->lock);
+#else
+	(void) d;
+#endif
+}
+
+static void batch_unlock(struct batch_Deque *d)
+{
+#ifdef USE_PTHREAD
+	pthread_mutex_unlock(&d->lock);
+#else
+	(void) d;
+#endif
+}
+
+/* Next model of worker `id`, stolen from another worker once its own are
+ * done (or -1 if no model is left)
+ */
+static int batch_next(struct batch_Deque *deques, const int id, const int nworkers)
+{
+	struct batch_Deque *own = deques + id;
+	int k = -1, v, lo = 0, hi = 0;
+
+	batch_lock(own);
+	if (own->lo < own->hi)
+		k = own->lo++;
+	batch_unlock(own);
+	for (v = 1; k < 0 && v < nworkers; v++) {
+		struct batch_Deque *d = deques + (id + v) % nworkers;
+
+		batch_lock(d);
+		if (d->lo < d->hi) {
+			hi = d->hi;
+			lo = hi - (hi - d->lo + 1) / 2;
+			d->hi = lo;
+			k = lo;
+		}
+		batch_unlock(d);
+	}
+	if (k >= 0 && lo + 1 < hi) {  /* keep the rest of the stolen half */
+		batch_lock(own);
+		own->lo = lo + 1;
+		own->hi = hi;
+		batch_unlock(own);
+	}
+	return k;
+}
+
+static void batch_task(void *arg, const int id, const int nworkers)
+{
+	struct batch_Job *job = (struct batch_Job *) arg;
+	struct lp_simplex_Options opts = {0};
+	int k;
+
+	if (job->opts)
+		opts = *job->opts;
+	opts.nthreads = 1;
+	opts.workspace = lp_simplex_workspace_create();  /* `NULL`: allocate per solve */
+	while ((k = batch_next(job->deques, id, nworkers)) >= 0) {
+		const struct lp_Model *md = job->models[k];
+
+		job->code[k] = lp_simplex_Success;
+		lp_simplex_opt(md->objective, md->constraints, md->bounds, md->m, md->n,
+			       job->criteria, job->niter, &opts, job->x[k], job->value + k, job->code + k);
+	}
+	lp_simplex_workspace_free(opts.workspace);
+}
+
+int lp_simplex_batch(struct lp_Model *const *models, const int nmodel, const char *criteria,
+			const int niter, const struct lp_simplex_Options *opts, const int nthreads,
+			double **x, double *value, int *code)
+{
+	struct lp_simplex_Pool *pool;
+	struct batch_Job job;
+	int k, w, nworkers;
+
+	assert(models != NULL || nmodel == 0);
+	assert(x != NULL || nmodel == 0);
+	assert(value != NULL || nmodel == 0);
+	assert(code != NULL || nmodel == 0);
+
+	pool = lp_simplex_pool_create(nthreads < nmodel ? nthreads : nmodel);
+	nworkers = lp_simplex_pool_size(pool);
+	job.deques = (struct batch_Deque *)lp_simplex_malloc(nworkers * sizeof(struct batch_Deque));
+	if (job.deques == NULL) {
+		lp_simplex_pool_free(pool);
+		for (k = 0; k < nmodel; k++)
+			code[k] = lp_simplex_MemoryAllocError;
+		return lp_simplex_EXIT_FAILURE;
+	}
+	for (w = 0; w < nworkers; w++) {
+		job.deques[w].lo = (int)((long)nmodel * w / nworkers);
+		job.deques[w].hi = (int)((long)nmodel * (w + 1) / nworkers);
+#ifdef USE_PTHREAD
+		pthread_mutex_init(&job.deques[w].lock, NULL);
+#endif
+	}
+	job.models = models;
+	job.criteria = criteria;
+	job.niter = niter;
+	job.opts = opts;
+	job.x = x;
+	job.value = value;
+	job.code = code;
+	lp_simplex_pool_run(pool, batch_task, &job);
+#ifdef USE_PTHREAD
+	for (w = 0; w < nworkers; w++)
+		pthread_mutex_destroy(&job.deques[w].lock);
+#endif
+	lp_simplex_free(job.deques);
+	lp_simplex_pool_free(pool);
+	for (k = 0; k < nmodel; k++) {
+		if (code[k] != lp_simplex_Success)
+			return lp_simplex_EXIT_FAILURE;
+	}
+	return lp_simplex_EXIT_SUCCESS;
+}
@@ -22,8 +22,51 @@
 /* Controller for pivot leaving rule */
 #define __lp_simplex_PIV_LEV__			1e-9
 
+/* Bound relaxation of Harris' ratio test */
+#define __lp_simplex_HARRIS_TOL__		1e-9
+
 #define __PAN_97_INVALID_BASIS_CRIT		1e-9
 
+/* Number of consecutive degenerate pivots before Bland's rule is used */
+#define __lp_simplex_DEGEN_ITER__		5
+
+/* Number of consecutive degenerate pivots reported as "degeneracy" */
+#define __lp_simplex_DEGEN_ITER_MAX__		1000
+
+/* Devex reference framework is reset when a weight exceeds this value */
+#define __lp_simplex_DEVEX_RESET__		1e6
+
+/* Pivot criteria */
+#define __lp_simplex_RULE_PAN97__		0
+#define __lp_simplex_RULE_DANTZIG__		1
+#define __lp_simplex_RULE_BLAND__		2
+#define __lp_simplex_RULE_STEEPEST__		3
+#define __lp_simplex_RULE_DEVEX__		4
+#define __lp_simplex_RULE_PARTIAL__		5
+#define __lp_simplex_RULE_MULTIPLE__		6
+
+/* Partial pricing: number of segments the columns are divided into */
+#define __lp_simplex_PARTIAL_NSEG__		8
+
+/* Multiple pricing: length of the candidate list */
+#define __lp_simplex_MULTIPLE_NCAND__		8
+
+/* Least number of table entries (m * (n + 1)) for a pivot to be shared by
+ * the worker pool; smaller pivots are cheaper than waking the workers up
+ */
+#define __lp_simplex_PARALLEL_MIN__		16384
+
+/* Pricing state kept across the iterations of `lp_simplex_bsc`
+ */
+struct simplex_Pricing {
+	struct lp_simplex_Weights *wt;	/* "steepest", "devex" */
+	int start;			/* "partial": first column of the next segment */
+	int *cand;			/* "multiple": candidate list */
+	int ncand;
+	int *rows;			/* "pan97": rows of the general basis */
+	double *u;			/* "pan97": Householder vector */
+};
+
 
 /* Check simplex optimality: all zero row coefficients are non-positive
  * Return:
@@ -32,13 +75,7 @@
  */
 static int is_simplex_optimal(const double *table, const int n)
 {
-	int j;
-
-	for (j = 0; j < n; j++) {
-		if (table[j] > __lp_simplex_CTR_SPLX_OPTIMAL__)
-			return 0;
-	}
-	return 1;
+	return !lp_simplex_kernel_any_above(table, __lp_simplex_CTR_SPLX_OPTIMAL__, n);
 }
 
 /* In simplex iteration, check whether value is improved.
@@ -58,94 +95,333 @@ static int check_simplex_degenerated(const double *table, const int n, const dou
 		return 0;
 }
 
-/* Choose the variable to leave basis
+/* Ratio of row i for entering column q, with the bound relaxed by `tol`
+ * Return `INF` if the basic variable of row i does not block column q;
+ * `side` is 1 if it leaves at zero and 2 if it leaves at its upper bound.
+ */
+static double simplex_row_ratio(const double *table, const int ldtable, const int *basis,
+				const struct lp_simplex_Bounds *bd, const int n, const int i, const int q,
+				const double tol, int *side)
+{
+	double y_i_0 = table[n + (i + 1) * ldtable];
+	double y_i_q = table[q + (i + 1) * ldtable];
+
+	if (bd && bd->lb[basis[i]] == __lp_simplex_NINF__)
+		return __lp_simplex_INF__;  /* free variables never leave the basis */
+	if (y_i_q > __lp_simplex_PIV_LEV__) {
+		*side = 1;
+		return __lp_simplex_MAX__(y_i_0 + tol, 0.) / y_i_q;
+	}
+	if (bd && y_i_q < -__lp_simplex_PIV_LEV__ && bd->ub[basis[i]] < __lp_simplex_INF__) {
+		*side = 2;
+		return __lp_simplex_MAX__(bd->ub[basis[i]] - y_i_0 + tol, 0.) / (-y_i_q);
+	}
+	return __lp_simplex_INF__;
+}
+
+/* Choose the variable to leave basis (Harris' two-pass ratio test)
  * Return the index of the variable and check weather LP is "bounded"
+ *
+ * Pass 1 finds the smallest ratio with bounds relaxed by HARRIS_TOL; pass 2
+ * takes, among the rows whose exact ratio is within it, the largest pivot
+ * element |y_i_q|, which avoids tiny pivots on (nearly) tied rows.
+ *
+ * With upper bounds `bd`, the entering variable may reach its own upper bound
+ * first and a basic variable may leave at its upper bound. `bounded` reports:
+ *	0	LP is unbounded
+ *	1	basic variable of row p leaves at zero
+ *	2	basic variable of row p leaves at its upper bound
+ *	3	entering variable reaches its upper bound (p = m)
  */
-static int simplex_pivot_leave_rule(const double *table, const int ldtable,
+static int simplex_pivot_leave_rule(const double *table, const int ldtable, const int *basis,
+				    const struct lp_simplex_Bounds *bd,
 				    const int m, const int n, const int q, int *bounded)
 {
-	int i, p = n;
-	double y_i_0, y_i_q, x_iq, min_x_iq = __lp_simplex_INF__;
+	int i, side, p = n;
+	double x_iq, y_i_q, max_y_iq = 0., min_x_iq = __lp_simplex_INF__;
 	*bounded = 0;
 
-	for (i = 0; i < m; i++) {
-		y_i_0 = table[n + (i + 1) * ldtable];
-		y_i_q = table[q + (i + 1) * ldtable];
-
-		if (y_i_q <= __lp_simplex_PIV_LEV__)
+	for (i = 0; i < m; i++) {  /* pass 1 */
+		x_iq = simplex_row_ratio(table, ldtable, basis, bd, n, i, q, __lp_simplex_HARRIS_TOL__, &side);
+		if (x_iq < min_x_iq)
+			min_x_iq = x_iq;
+	}
+	if (bd && bd->ub[q] < __lp_simplex_INF__ && bd->ub[q] <= min_x_iq) {
+		*bounded = 3;
+		return m;
+	}
+	if (min_x_iq == __lp_simplex_INF__)
+		return p;
+	for (i = 0; i < m; i++) {  /* pass 2 */
+		x_iq = simplex_row_ratio(table, ldtable, basis, bd, n, i, q, 0., &side);
+		if (x_iq > min_x_iq)
 			continue;
-		else {
-			x_iq = y_i_0 / y_i_q;
-
-			if (x_iq < min_x_iq) {
-				min_x_iq = x_iq;
-				p = i;
-			}
-			*bounded = 1;
+		y_i_q = __lp_simplex_ABS__(table[q + (i + 1) * ldtable]);
+		if (y_i_q > max_y_iq) {
+			max_y_iq = y_i_q;
+			p = i;
+			*bounded = side;
 		}
 	}
 	return p;
 }
 
+/* Complement column j at its upper bound: x_j = ub_j - x_j'
+ * (rows 0, ..., m: rhs -= y_i_j * ub_j and y_i_j = -y_i_j)
+ */
+static void simplex_complement_col(double *table, const int ldtable, const int m, const int n,
+					const int j, const double ub)
+{
+	int i, rowi;
+
+	for (i = 0; i <= m; i++) {
+		rowi = i * ldtable;
+		table[n + rowi] -= table[j + rowi] * ub;
+		table[j + rowi] = -table[j + rowi];
+	}
+}
+
+/* Negate nonbasic free columns whose beta is negative, so that they enter
+ * the basis by increasing like the other columns
+ */
+static void simplex_free_direction(double *table, const int ldtable, const struct lp_simplex_BasisIndex *idx,
+					struct lp_simplex_Bounds *bd, const int m, const int n)
+{
+	int j, k;
+
+	for (k = 0; k < idx->nnonbasic; k++) {
+		j = idx->nonbasic[k];
+		if (bd->lb[j] == __lp_simplex_NINF__ && table[j] < -__lp_simplex_CTR_SPLX_OPTIMAL__) {
+			simplex_complement_col(table, ldtable, m, n, j, 0.);
+			bd->flip[j] = !bd->flip[j];
+		}
+	}
+}
+
+/* Complement the basic variable of row p at its upper bound: x_j = ub_j - x_j'
+ * (row p is negated but its unit entry, and its rhs becomes ub_j - rhs)
+ */
+static void simplex_complement_row(double *table, const int ldtable, const int n,
+					const int p, const int j, const double ub)
+{
+	int rowp = (p + 1) * ldtable;
+
+	lp_simplex_linalg_dscal(n + 1, -1., table + rowp, 1);
+	table[n + rowp] += ub;
+	table[j + rowp] = 1.;
+}
+
 /* Fast pivot rule: choosing the variable to enter basis
- * Return the index of the variable (< n)
+ * Return the position of the variable in the nonbasic list
  *
  * Note:
- * 	On failure, the algorithm returns `n`. Logically, this NEVER happens,
+ * 	On failure, the algorithm returns `nnonbasic`. Logically, this NEVER happens,
  *	but numerically, there are many criteriors reporting optimality,
  *	leading to unpredicted results
  */
-static int simplex_pivot_enter_rule_datzig(const double *table, const int *basis, const int m, const int n)
+static int simplex_pivot_enter_rule_datzig(const double *table, const struct lp_simplex_BasisIndex *idx)
+{
+	/* return nnonbasic if no p is found (optimal already) */
+	return lp_simplex_kernel_argmax_at(table, idx->nonbasic, 0., idx->nnonbasic);
+}
+
+/* Bland's rule: choosing the variable to enter basis
+ * Return the position of the variable in the nonbasic list
+ *
+ * Note: on failure, the algorithm returns nnonbasic
+ */
+static int simplex_pivot_enter_rule_bland(const double *table, const struct lp_simplex_BasisIndex *idx)
+{
+	int j, k, q = idx->nnonbasic;
+	double epsilon = __lp_simplex_BLAND_EPS__;
+BLAND_BEGIN:
+	for (k = 0; k < idx->nnonbasic; k++) {  /* smallest index among candidates */
+		j = idx->nonbasic[k];
+		if (table[j] > epsilon && (q == idx->nnonbasic || j < idx->nonbasic[q]))
+			q = k;
+	}
+	if (q < idx->nnonbasic)
+		return q;
+	if (epsilon >= __lp_simplex_BLAND_EPS_MIN__) {
+		epsilon /= 10.;
+		goto BLAND_BEGIN;
+	} else
+		return idx->nnonbasic;
+}
+
+/* Partial pricing: choosing the variable to enter basis
+ * Return the position of the variable in the nonbasic list
+ *
+ * Segments of about nnonbasic / NSEG columns are scanned in a rotating order
+ * and the best column of the first segment with a candidate is returned
+ *
+ * Note: on failure, the algorithm returns nnonbasic
+ */
+static int simplex_pivot_enter_rule_partial(const double *table, const struct lp_simplex_BasisIndex *idx,
+						struct simplex_Pricing *pr)
 {
-	int j, q = n;
+	int k, t, nnb = idx->nnonbasic, q = nnb;
+	int seg = __lp_simplex_MAX__(nnb / __lp_simplex_PARTIAL_NSEG__, 1);
 	double beta_j = 0.;
-	double beta_q = 0.;
+	double beta_q = __lp_simplex_CTR_SPLX_OPTIMAL__;
 
-	for (j = 0; j < n; j++) {
-		if (is_in_arri(j, basis, m))
-			continue;
-		beta_j = table[j];
+	k = pr->start < nnb ? pr->start : 0;
+	for (t = 1; t <= nnb; t++) {
+		beta_j = table[idx->nonbasic[k]];
 
 		if (beta_j > beta_q) {
-			q = j;
+			q = k;
 			beta_q = beta_j;
 		}
+		k = k + 1 < nnb ? k + 1 : 0;
+		if ((t % seg == 0 || t == nnb) && q < nnb)
+			break;
 	}
-	return q; /* return n if no p is found (optimal already) */
+	pr->start = k;
+	return q;
 }
 
-/* Bland's rule: choosing the variable to enter basis
- * Return the index of the variable (< n)
+/* Multiple pricing: choosing the variable to enter basis
+ * Return the position of the variable in the nonbasic list
+ *
+ * A full scan keeps the NCAND most attractive columns; the following
+ * iterations only price these candidates until none of them is attractive
  *
- * Note: on failure, the algorithm returns n
+ * Note: on failure, the algorithm returns nnonbasic
  */
-static int simplex_pivot_enter_rule_bland(const double *table, const int *basis, const int m, const int n)
+static int simplex_pivot_enter_rule_multiple(const double *table, const struct lp_simplex_BasisIndex *idx,
+						struct simplex_Pricing *pr)
 {
-	int j;
-	double epsilon = __lp_simplex_BLAND_EPS__;
-BLAND_BEGIN:
+	int k, t, nnb = idx->nnonbasic, q = nnb;
+	double beta_j = 0.;
+	double beta_q = __lp_simplex_CTR_SPLX_OPTIMAL__;
+
+	for (t = 0; t < pr->ncand; t++) {
+		k = pr->cand[t];
+		if (k >= nnb || table[idx->nonbasic[k]] <= __lp_simplex_CTR_SPLX_OPTIMAL__) {
+			pr->cand[t--] = pr->cand[--pr->ncand];  /* drop unattractive candidate */
+			continue;
+		}
+		if (table[idx->nonbasic[k]] > beta_q) {
+			q = k;
+			beta_q = table[idx->nonbasic[k]];
+		}
+	}
+	if (q < nnb)
+		return q;
+	for (k = 0; k < nnb; k++) {  /* rebuild the candidate list sorted by beta */
+		beta_j = table[idx->nonbasic[k]];
+		if (beta_j <= __lp_simplex_CTR_SPLX_OPTIMAL__)
+			continue;
+		if (pr->ncand == __lp_simplex_MULTIPLE_NCAND__) {
+			if (beta_j <= table[idx->nonbasic[pr->cand[pr->ncand - 1]]])
+				continue;
+			pr->ncand--;
+		}
+		for (t = pr->ncand; t > 0 && table[idx->nonbasic[pr->cand[t - 1]]] < beta_j; t--)
+			pr->cand[t] = pr->cand[t - 1];
+		pr->cand[t] = k;
+		pr->ncand++;
+	}
+	return pr->ncand > 0 ? pr->cand[0] : nnb;
+}
+
+/* Weighted pivot rule (steepest edge or Devex): choosing the variable to enter basis
+ * Return the position in the nonbasic list of the variable maximizing beta_j^2 / gamma_j
+ *
+ * Note: on failure, the algorithm returns nnonbasic
+ */
+static int simplex_pivot_enter_rule_weighted(const double *table, const struct lp_simplex_BasisIndex *idx,
+						const double *gamma)
+{
+	int j, k, q = idx->nnonbasic;
+	double beta_j, score, best = 0.;
+
+	for (k = 0; k < idx->nnonbasic; k++) {
+		j = idx->nonbasic[k];
+		beta_j = table[j];
+		if (beta_j <= __lp_simplex_CTR_SPLX_OPTIMAL__)
+			continue;
+		score = beta_j * beta_j / gamma[j];
+
+		if (score > best) {
+			q = k;
+			best = score;
+		}
+	}
+	return q;
+}
+
+/* Initialize reference weights of all columns
+ *
+ *	steepest	gamma_j = 1 + ||y_j||^2 (exact, basic columns have 2)
+ *	devex		gamma_j = 1
+ */
+static void simplex_weights_init(struct lp_simplex_Weights *wt, const double *table, const int ldtable,
+					const int m, const int n)
+{
+	int i, j;
+	double y_i_j;
+
+	for (j = 0; j < n; j++)
+		wt->gamma[j] = 1.;
+	if (wt->rule != lp_simplex_WEIGHTS_STEEPEST)
+		return;
+	for (i = 0; i < m; i++) {
+		for (j = 0; j < n; j++) {
+			y_i_j = table[j + (i + 1) * ldtable];
+			wt->gamma[j] += y_i_j * y_i_j;
+		}
+	}
+}
+
+/* Update of reference weights after pivoting on (p, q)
+ *
+ * With r_j = y_p_j / y_p_q read from the normalized row p:
+ *	steepest	gamma_j = max(gamma_j - 2 r_j y_j'y_q + r_j^2 gamma_q, 1 + r_j^2)
+ *	devex		gamma_j = max(gamma_j, r_j^2 gamma_q)
+ *
+ * Basic columns are unit columns, so the leaving variable is covered by
+ * the same formula and the entering one is reset to its unit weight.
+ */
+static void simplex_weights_update(struct lp_simplex_Weights *wt, const double *table, const int ldtable,
+					const int n, const int p, const int q)
+{
+	int j, rowp = (p + 1) * ldtable;
+	double r, g, gamma_q = wt->gamma[q];
+
 	for (j = 0; j < n; j++) {
-		if (!is_in_arri(j, basis, m)) {
-			if (table[j] > epsilon)
-				return j;
+		r = table[j + rowp];
+		if (j == q || r == 0.)
+			continue;
+		if (wt->rule == lp_simplex_WEIGHTS_STEEPEST) {
+			g = wt->gamma[j] - 2 * r * wt->work[j] + r * r * gamma_q;
+			wt->gamma[j] = __lp_simplex_MAX__(g, 1 + r * r);
+		} else
+			wt->gamma[j] = __lp_simplex_MAX__(wt->gamma[j], r * r * gamma_q);
+	}
+	if (wt->rule == lp_simplex_WEIGHTS_STEEPEST)
+		wt->gamma[q] = 2.;
+	else {
+		wt->gamma[q] = 1.;
+		for (j = 0; j < n; j++) {
+			if (wt->gamma[j] > __lp_simplex_DEVEX_RESET__)
+				break;
+		}
+		if (j < n) {  /* reset reference framework */
+			for (j = 0; j < n; j++)
+				wt->gamma[j] = 1.;
 		}
 	}
-	if (epsilon >= __lp_simplex_BLAND_EPS_MIN__) {
-		epsilon /= 10.;
-		goto BLAND_BEGIN;
-	} else
-		return n;
 }
 
 /* The transforming of proposed by Pan (1997)
  */
 void simplex_pan97_trsf(const double *table, const int ldtable, const int *basis,
-			const int m, const int n, const int p, const int q)
+			const int m, const int n, const int p, const int q,
+			int *non_basis_1, double *vec_u)
 {
-	int *non_basis_1 = (int *)lp_simplex_malloc(sizeof(int) * m);
-
-	/* H = I - tau * u * u^T */
-	double *vec_u = (double *)lp_simplex_malloc(sizeof(double) * m);
+	/* H = I - tau * u * u^T (`non_basis_1` and `vec_u` of length m) */
 	double tau = 0, beta = 0;
 
 	int i, j, k = 0;
@@ -153,9 +429,9 @@ void simplex_pan97_trsf(const double *table, const int ldtable, const int *basis
 
 	/* calculate m1 and general basis, copy column "q" */
 	for (i = 0; i < m; i++) {
-		if (table[(i + 1) * (n + 1) + n] < __PAN_97_INVALID_BASIS_CRIT) {
+		if (table[(i + 1) * ldtable + n] < __PAN_97_INVALID_BASIS_CRIT) {
 			m1--;
-			vec_u[k] = table[(i + 1) * (n + 1) + q];
+			vec_u[k] = table[(i + 1) * ldtable + q];
 			non_basis_1[k] = i;
 			k++;
 		}
@@ -168,8 +444,7 @@ void simplex_pan97_trsf(const double *table, const int ldtable, const int *basis
 	vec_u[0] = 1.0;
 
 END:
-	lp_simplex_free(non_basis_1);
-	lp_simplex_free(vec_u);
+	return;
 }
 
 /* Key subroutine of pivoting given p and q
@@ -177,33 +452,122 @@ END:
  * Parameter:
  *	p	idx of variable to leave basis
  *	q	idx of variable to enter basis
+ *	wt	reference weights to be updated (or `NULL`)
  *
  * Work:
  *	rule 1. row_p normalized by dividing y_p_q
  *	rule 2. row_i -= row_p * y_i_q
  *	rule 3. row_0 -= row_p * beta_q
  */
-void lp_simplex_pivot_core(double *table, const int ldtable,
+/* Rows of rule2 and rule3 shared by the workers of a pool
+ */
+struct simplex_RowUpdate {
+	double *table;
+	int ldtable;
+	int ncol;
+	int p;		/* row of the pivot in `table` */
+	int q;
+	int begin;	/* rows [begin, end) of `table` */
+	int end;
+};
+
+/* Worker `id` of `nworkers` updates a contiguous block of rows
+ * (each row is touched by exactly one worker, as in the serial kernel)
+ */
+static void simplex_row_update(void *arg, const int id, const int nworkers)
+{
+	const struct simplex_RowUpdate *task = (const struct simplex_RowUpdate *) arg;
+	int nrow = task->end - task->begin;
+
+	lp_simplex_kernel_rank1(task->table, task->ldtable, task->ncol, task->p, task->q,
+				task->begin + nrow * id / nworkers, task->begin + nrow * (id + 1) / nworkers);
+}
+
+void lp_simplex_pivot_core_ex(double *table, const int ldtable,
 			const int m, const int n, const int p, const int q,
-			const int rule1, const int rule2, const int rule3)
+			const int rule1, const int rule2, const int rule3,
+			struct lp_simplex_Weights *wt, struct lp_simplex_Pool *pool)
 {
 	int i, ncol = n + 1, rowp = (p + 1) * ldtable;
+	int begin = rule3 ? 0 : 1, end = rule2 ? m + 1 : 1;  /* rows of the rank-1 update */
 	double y_p_q = table[q + rowp];
 
-	if (rule1)
-		lp_simplex_linalg_dscal(ncol, 1 / y_p_q, table + rowp, 1);
-	if (rule2) {
+	if (wt && wt->rule == lp_simplex_WEIGHTS_STEEPEST) {  /* work = sum_i y_i_q * row_i */
+		lp_simplex_memset(wt->work, 0, n * sizeof(double));
 		for (i = 0; i < m; i++) {
-			int rowi = (i + 1) * ldtable;
-			double rto =  -table[q + rowi];
+			double y_i_q = table[q + (i + 1) * ldtable];
 
-			if (i == p)
-				continue;
-			lp_simplex_linalg_daxpy(ncol, rto, table + rowp, 1, table + rowi, 1);
+			if (y_i_q != 0.)
+				lp_simplex_linalg_daxpy(n, y_i_q, table + (i + 1) * ldtable, 1, wt->work, 1);
 		}
 	}
-	if (rule3)
-		lp_simplex_linalg_daxpy(ncol, -table[q], table + rowp, 1, table, 1);
+	if (rule1)
+		lp_simplex_kernel_scale(table + rowp, 1 / y_p_q, ncol);
+	if (pool && (end - begin) * ncol >= __lp_simplex_PARALLEL_MIN__) {
+		struct simplex_RowUpdate task;
+
+		task.table = table;
+		task.ldtable = ldtable;
+		task.ncol = ncol;
+		task.p = p + 1;
+		task.q = q;
+		task.begin = begin;
+		task.end = end;
+		lp_simplex_pool_run(pool, simplex_row_update, &task);
+	} else if (begin < end)
+		lp_simplex_kernel_rank1(table, ldtable, ncol, p + 1, q, begin, end);
+	if (wt)
+		simplex_weights_update(wt, table, ldtable, n, p, q);
+}
+
+void lp_simplex_pivot_core(double *table, const int ldtable,
+			const int m, const int n, const int p, const int q,
+			const int rule1, const int rule2, const int rule3)
+{
+	lp_simplex_pivot_core_ex(table, ldtable, m, n, p, q, rule1, rule2, rule3, NULL, NULL);
+}
+
+/* Parse the pivot criteria
+ */
+static int simplex_criteria(const char *criteria)
+{
+	size_t len = lp_simplex_strlen(criteria);
+
+	if (7 == len && 0 == lp_simplex_memcmp("dantzig", criteria, 7))
+		return __lp_simplex_RULE_DANTZIG__;
+	if (5 == len && 0 == lp_simplex_memcmp("bland", criteria, 5))
+		return __lp_simplex_RULE_BLAND__;
+	if (8 == len && 0 == lp_simplex_memcmp("steepest", criteria, 8))
+		return __lp_simplex_RULE_STEEPEST__;
+	if (5 == len && 0 == lp_simplex_memcmp("devex", criteria, 5))
+		return __lp_simplex_RULE_DEVEX__;
+	if (7 == len && 0 == lp_simplex_memcmp("partial", criteria, 7))
+		return __lp_simplex_RULE_PARTIAL__;
+	if (8 == len && 0 == lp_simplex_memcmp("multiple", criteria, 8))
+		return __lp_simplex_RULE_MULTIPLE__;
+	return __lp_simplex_RULE_PAN97__;
+}
+
+/* Build the index of the basis
+ *
+ * Columns `>= n` in `basis` (e.g. artificial variables left on redundant
+ * rows) are basic but never enter the nonbasic list
+ */
+void lp_simplex_basis_index(struct lp_simplex_BasisIndex *idx, const int *basis, const int m, const int n)
+{
+	int i, j;
+
+	for (j = 0; j < n; j++)
+		idx->bpos[j] = -1;
+	for (i = 0; i < m; i++) {
+		if (basis[i] < n)
+			idx->bpos[basis[i]] = i;
+	}
+	idx->nnonbasic = 0;
+	for (j = 0; j < n; j++) {
+		if (idx->bpos[j] < 0)
+			idx->nonbasic[idx->nnonbasic++] = j;
+	}
 }
 
 /* Pivot starting from a basic representation for one round
@@ -214,67 +578,153 @@ void lp_simplex_pivot_core(double *table, const int ldtable,
  *	2: LP is unbounded
  *	9: numerical precision error
  */
-static int lp_simplex_pivot_on(double *table, const int ldtable, int *basis,
-				const int m, const int n, const char *criteria)
+static int lp_simplex_pivot_on(double *table, const int ldtable, int *basis, struct lp_simplex_BasisIndex *idx,
+				struct lp_simplex_Bounds *bd, const int m, const int n, const int rule,
+				struct simplex_Pricing *pr, struct lp_simplex_Pool *pool)
 {
 	int bounded = 0;
-	int q = 0, p = 0;
+	int k = 0, q = 0, p = 0, l;
 
+	if (bd && bd->nfree > 0)
+		simplex_free_direction(table, ldtable, idx, bd, m, n);
 	if (is_simplex_optimal(table, n))
 		return 1;
-	if (7 == lp_simplex_strlen(criteria) && 0 == lp_simplex_memcmp("dantzig", criteria, 7)) {
-		q = simplex_pivot_enter_rule_datzig(table, basis, m, n);
-		p = simplex_pivot_leave_rule(table, ldtable, m, n, q, &bounded);
-	}
-	else if (5 == lp_simplex_strlen(criteria) && 0 == lp_simplex_memcmp("bland", criteria, 5)) {
-		q = simplex_pivot_enter_rule_bland(table, basis, m, n);
-		p = simplex_pivot_leave_rule(table, ldtable, m, n, q, &bounded);
+	switch (rule) {
+	case __lp_simplex_RULE_DANTZIG__:
+		k = simplex_pivot_enter_rule_datzig(table, idx);
+		break;
+	case __lp_simplex_RULE_BLAND__:
+		k = simplex_pivot_enter_rule_bland(table, idx);
+		break;
+	case __lp_simplex_RULE_STEEPEST__:
+	case __lp_simplex_RULE_DEVEX__:
+		k = simplex_pivot_enter_rule_weighted(table, idx, pr->wt->gamma);
+		break;
+	case __lp_simplex_RULE_PARTIAL__:
+		k = simplex_pivot_enter_rule_partial(table, idx, pr);
+		break;
+	case __lp_simplex_RULE_MULTIPLE__:
+		k = simplex_pivot_enter_rule_multiple(table, idx, pr);
+		break;
+	default:  /* default method: "pan97" */
+		k = simplex_pivot_enter_rule_datzig(table, idx);
+		if (k < idx->nnonbasic)
+			simplex_pan97_trsf(table, ldtable, basis, m, n, p, idx->nonbasic[k],
+					   pr->rows, pr->u);
+		break;
 	}
-	else {  /* default method: "pan97" */
-		q = simplex_pivot_enter_rule_datzig(table, basis, m, n);
-		simplex_pan97_trsf(table, ldtable, basis, m, n, p, q);
-		p = simplex_pivot_leave_rule(table, ldtable, m, n, q, &bounded);
-	}
-	if (n <= q) {
+	if (idx->nnonbasic <= k) {
 		return 9;
 	}
+	q = idx->nonbasic[k];
+	p = simplex_pivot_leave_rule(table, ldtable, basis, bd, m, n, q, &bounded);
 	if (bounded == 0)
 		return 2;
+	if (bounded == 3) {  /* bound flip, the basis is unchanged */
+		simplex_complement_col(table, ldtable, m, n, q, bd->ub[q]);
+		bd->flip[q] = !bd->flip[q];
+		return 0;
+	}
+	l = basis[p];
+	if (bounded == 2) {
+		simplex_complement_row(table, ldtable, n, p, l, bd->ub[l]);
+		bd->flip[l] = !bd->flip[l];
+	}
 	basis[p] = q;
-	lp_simplex_pivot_core(table, ldtable, m, n, p, q, 1, 1, 1);
+	idx->bpos[q] = p;
+	if (l < n) {
+		idx->bpos[l] = -1;
+		idx->nonbasic[k] = l;
+	} else
+		idx->nonbasic[k] = idx->nonbasic[--idx->nnonbasic];
+	lp_simplex_pivot_core_ex(table, ldtable, m, n, p, q, 1, 1, 1, pr->wt, pool);
 	return 0;
 }
 
-int lp_simplex_bsc(int *epoch, double *table, const int ldtable, int *basis,
+int lp_simplex_bsc_ex(int *epoch, double *table, const int ldtable, int *basis,
+			struct lp_simplex_BasisIndex *idx, struct lp_simplex_Bounds *bd,
 			const int m, const int n, const int nreal,
-			const char *criteria, const int niter)
+			const char *criteria, const int niter, struct lp_simplex_Pool *pool,
+			struct lp_simplex_Workspace *ws)
 {
 	double old_value = __lp_simplex_INF__;
-	int degen_iter = 0;
+	int degen_iter = 0, state = 0;
+	int rule = simplex_criteria(criteria);
+	struct lp_simplex_Weights weights;
+	struct lp_simplex_BasisIndex index;
+	struct simplex_Pricing pricing;
+	int cand[__lp_simplex_MULTIPLE_NCAND__];
 
 	assert(table != NULL);
 	assert(basis != NULL);
 	assert(epoch != NULL);
 
+	index.bpos = NULL;
+	pricing.rows = NULL;
+	pricing.u = NULL;
+	weights.gamma = NULL;
+	if (idx == NULL) {  /* index owned by this call */
+		index.bpos = (int *)lp_simplex_ws_alloc(ws, __lp_simplex_WS_INDEX__, 2 * (n + 1) * sizeof(int));
+		if (index.bpos == NULL)
+			return 4;
+		index.nonbasic = index.bpos + n + 1;
+		lp_simplex_basis_index(&index, basis, m, n);
+		idx = &index;
+	}
+	pricing.wt = NULL;
+	pricing.start = 0;
+	pricing.cand = cand;
+	pricing.ncand = 0;
+	if (rule == __lp_simplex_RULE_STEEPEST__ || rule == __lp_simplex_RULE_DEVEX__) {
+		weights.rule = rule == __lp_simplex_RULE_STEEPEST__ ?
+				lp_simplex_WEIGHTS_STEEPEST : lp_simplex_WEIGHTS_DEVEX;
+		weights.gamma = (double *)lp_simplex_ws_alloc(ws, __lp_simplex_WS_GAMMA__,
+							      2 * (n + 1) * sizeof(double));
+		if (weights.gamma == NULL) {
+			state = 4;
+			goto END;
+		}
+		weights.work = weights.gamma + n + 1;
+		pricing.wt = &weights;
+		simplex_weights_init(&weights, table, ldtable, m, n);
+	} else if (rule == __lp_simplex_RULE_PAN97__) {
+		pricing.rows = (int *)lp_simplex_ws_alloc(ws, __lp_simplex_WS_PAN97I__, (m + 1) * sizeof(int));
+		pricing.u = (double *)lp_simplex_ws_alloc(ws, __lp_simplex_WS_PAN97D__, (m + 1) * sizeof(double));
+		if (pricing.rows == NULL || pricing.u == NULL) {
+			state = 4;
+			goto END;
+		}
+	}
 	while (*epoch < niter) {
 		(*epoch)++;
-		switch (lp_simplex_pivot_on(table, ldtable, basis, m, n, criteria)) {
-		case 0:
-			break;
-		case 1:
-			return 1;
-		case 2:
-			return 2;
-		case 9:
-			return 9;
-		}
+		/* Bland's rule takes over on degenerate stalling (anti-cycling) */
+		state = lp_simplex_pivot_on(table, ldtable, basis, idx, bd, m, n,
+					degen_iter > __lp_simplex_DEGEN_ITER__ ? __lp_simplex_RULE_BLAND__ : rule,
+					&pricing, pool);
+		if (state != 0)
+			goto END;
 		if (check_simplex_degenerated(table, n, old_value) == 2) {
 			degen_iter++;
-			if (degen_iter > 5)
-				return 3;
+			if (degen_iter > __lp_simplex_DEGEN_ITER_MAX__) {
+				state = 3;
+				goto END;
+			}
 		} else
 			degen_iter = 0;
 		old_value = table[n];
 	}
-	return 0;
+END:
+	lp_simplex_ws_free(ws, pricing.u);
+	lp_simplex_ws_free(ws, pricing.rows);
+	lp_simplex_ws_free(ws, weights.gamma);
+	lp_simplex_ws_free(ws, index.bpos);
+	return state;
+}
+
+int lp_simplex_bsc(int *epoch, double *table, const int ldtable, int *basis,
+			const int m, const int n, const int nreal,
+			const char *criteria, const int niter)
+{
+	return lp_simplex_bsc_ex(epoch, table, ldtable, basis, NULL, NULL, m, n, nreal,
+				 criteria, niter, NULL, NULL);
 }
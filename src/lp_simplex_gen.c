@@ -5,120 +5,68 @@
 #include <lp_simplex/lp_simplex_utils.h>
 #include <lp_simplex/lp_simplex.h>
 
-static int stdlpf_alloc(const int M, const int N, double **obj2, double **x2, double **coef2,
-			struct optm_LinearConstraint **constraints2)
+static void stdlpf_free(struct lp_simplex_Workspace *ws, double *obj2, double *x2, double *bnd2,
+			double *coef2, struct optm_LinearConstraint *constraints2)
 {
-	*obj2 = NULL;
-	*x2 = NULL;
-	*coef2 = NULL;
-	*constraints2 = NULL;
-
-	*obj2 = lp_simplex_malloc(N * sizeof(double));
-	if (*obj2 == NULL)
-		return lp_simplex_EXIT_FAILURE;
-	*x2 = lp_simplex_malloc(N * sizeof(double));
-	if (*x2 == NULL) {
-		lp_simplex_free(*obj2);
-		return lp_simplex_EXIT_FAILURE;
-	}
-	*coef2 = lp_simplex_malloc(M * N * sizeof(double));
-	if (*coef2 == NULL) {
-		lp_simplex_free(*obj2);
-		lp_simplex_free(*x2);
-		return lp_simplex_EXIT_FAILURE;
-	}
-	*constraints2 = lp_simplex_malloc(M * sizeof(struct optm_LinearConstraint));
-	if (*constraints2 == NULL) {
-		lp_simplex_free(*obj2);
-		lp_simplex_free(*x2);
-		lp_simplex_free(*coef2);
-		return lp_simplex_EXIT_FAILURE;
-	}
-	return lp_simplex_EXIT_SUCCESS;
+	lp_simplex_ws_free(ws, obj2);
+	lp_simplex_ws_free(ws, x2);
+	lp_simplex_ws_free(ws, bnd2);
+	lp_simplex_ws_free(ws, coef2);
+	lp_simplex_ws_free(ws, constraints2);
 }
 
-static void stdlpf_free(double *obj2, double *x2, double *coef2, struct optm_LinearConstraint *constraints2)
+static int stdlpf_alloc(struct lp_simplex_Workspace *ws, const int M, const int N,
+			double **obj2, double **x2, double **bnd2, double **coef2,
+			struct optm_LinearConstraint **constraints2)
 {
-	if (obj2)
-		lp_simplex_free(obj2);
-	if (x2)
-		lp_simplex_free(x2);
-	if (coef2)
-		lp_simplex_free(coef2);
-	if (constraints2)
-		lp_simplex_free(constraints2);
+	*obj2 = lp_simplex_ws_alloc(ws, __lp_simplex_WS_OBJ2__, N * sizeof(double));
+	*x2 = lp_simplex_ws_alloc(ws, __lp_simplex_WS_X2__, N * sizeof(double));
+	*bnd2 = lp_simplex_ws_alloc(ws, __lp_simplex_WS_BND2__, 2 * N * sizeof(double));
+	*coef2 = lp_simplex_ws_alloc(ws, __lp_simplex_WS_COEF2__, M * N * sizeof(double));
+	*constraints2 = lp_simplex_ws_alloc(ws, __lp_simplex_WS_CONS2__, M * sizeof(struct optm_LinearConstraint));
+	if (*obj2 && *x2 && *bnd2 && *coef2 && *constraints2)
+		return lp_simplex_EXIT_SUCCESS;
+	stdlpf_free(ws, *obj2, *x2, *bnd2, *coef2, *constraints2);
+	return lp_simplex_EXIT_FAILURE;
 }
 
-/* Get the size of standard form LP
+/* Variable transformation 0: "xj <= ub" and "free xj"
  *
- * Rules:
- *	1. free variable x = y1 - y2
- *	2. "x <= ub" will be added to constraints
- */
-static void stdlpf_size(const struct optm_VariableBound *bounds, const int m, const int n, int *_M, int *_N)
-{
-	int j;
-	*_M = m;
-	*_N = n;
-
-	for (j = 0; j < n; j++) {
-		const struct optm_VariableBound *bd = bounds + j;
-
-		if (optm_BOUND_T_FR == bd->b_type)
-			(*_N)++;
-		if (optm_BOUND_T_UP == bd->b_type || optm_BOUND_T_BS == bd->b_type)
-			(*_M)++;
-	}
-}
-
-/* Variable transformation 0: "xj <= ub"
+ * Neither adds a row nor a column: bounds are kept in `lb2` (0 or -INF for a
+ * free variable) and `ub2`, and handled by the simplex algorithm
  */
 static void lp_transf_0(const double *objective, const struct optm_LinearConstraint *constraints,
-			const struct optm_VariableBound *bounds, const int m, const int _N, const int j,
-			int *ctr_var, int *ctr_ubcons, double *obj2,
-			double *coef2, struct optm_LinearConstraint *constraints2)
+			const struct optm_VariableBound *bounds, const int m, const int n, const int j,
+			double *obj2, double *lb2, double *ub2, double *coef2)
 {
-	int i, idx;
+	int i;
 	const struct optm_VariableBound *bd;
 
 	bd = bounds + j;
-	obj2[*ctr_var] = objective[j];
-
-	if (optm_BOUND_T_UP == bd->b_type || optm_BOUND_T_BS == bd->b_type) {
-		idx = m + (*ctr_ubcons);
-		constraints2[idx].coef = coef2 + idx * _N;
-		constraints2[idx].rhs = bd->ub;
-		constraints2[idx].type = optm_CONS_T_LE;
-		constraints2[idx].coef[*ctr_var] = 1.;
-		(*ctr_ubcons)++;
-	}
-	for (i = 0; i < m; i++)
-		coef2[(*ctr_var) + i * _N] = (constraints + i)->coef[j];
-	(*ctr_var)++;
-}
-
-/* Variable transformation 1: "free xj" => "xj = y1 - y2" with y1, y2 >=0
- */
-static void lp_transf_1(const double *objective, const struct optm_LinearConstraint *constraints,
-			const struct optm_VariableBound *bounds, const int m, const int _N, const int j,
-			int *ctr_var, double *obj2, double *coef2)
-{
-	int i;
-
-	if (optm_BOUND_T_FR != (bounds + j)->b_type)
-		return;
-	obj2[*ctr_var] = -objective[j];
+	obj2[j] = objective[j];
+	lb2[j] = 0.;
+	ub2[j] = __lp_simplex_INF__;
 
+	switch (bd->b_type) {
+	case optm_BOUND_T_FR:
+		lb2[j] = __lp_simplex_NINF__;
+		break;
+	case optm_BOUND_T_UP:
+		ub2[j] = bd->ub;
+		break;
+	case optm_BOUND_T_BS:
+		ub2[j] = bd->ub - bd->lb;
+		break;
+	}
 	for (i = 0; i < m; i++)
-		coef2[(*ctr_var) + i * _N] = -((constraints + i)->coef[j]);
-	(*ctr_var)++;
+		coef2[j + i * n] = (constraints + i)->coef[j];
 }
 
 /* Variable transformation 2: "xj >= lb" => "y >= 0"
  */
 static void lp_transf_2(const double *objective, const struct optm_LinearConstraint *constraints,
-			const struct optm_VariableBound *bounds, const int m, const int _M, const int j,
-			double *obj2, double *obj_diff, struct optm_LinearConstraint *constraints2)
+			const struct optm_VariableBound *bounds, const int m, const int j,
+			double *obj_diff, struct optm_LinearConstraint *constraints2)
 {
 	int i;
 	const struct optm_VariableBound *bd = bounds + j;
@@ -127,39 +75,31 @@ static void lp_transf_2(const double *objective, const struct optm_LinearConstra
 		return;
 	*obj_diff += objective[j] * bd->lb;
 
-	for (i = 0; i < _M; i++) {
-		struct optm_LinearConstraint *cons = constraints2 + i;
-
-		if (i < m)
-			cons->rhs -= ((constraints + i)->coef[j]) * (bd->lb);
-		else
-			cons->rhs -= bd->lb;
-	}
+	for (i = 0; i < m; i++)
+		(constraints2 + i)->rhs -= ((constraints + i)->coef[j]) * (bd->lb);
 }
 
 /* Transform original LP into standard form
  *
  * Note:
  *	Original LP: allow for more variable bounds
- *	Standard LP: x >= 0
+ *	Standard LP: 0 <= x <= ub, or x free
  */
 static void lp_transstd(const double *objective, const struct optm_LinearConstraint *constraints,
-			const struct optm_VariableBound *bounds, const int m, const int n, const int _M, const int _N,
-			double *obj2, double *obj_diff, double *coef2, struct optm_LinearConstraint *constraints2)
+			const struct optm_VariableBound *bounds, const int m, const int n,
+			double *obj2, double *obj_diff, double *lb2, double *ub2, double *coef2,
+			struct optm_LinearConstraint *constraints2)
 {
 	int i, j;
-	int ctr_var = 0;
-	int ctr_ubcons = 0;
 
 	for (i = 0; i < m; i++) {
-		constraints2[i].coef = coef2 + i * _N;
+		constraints2[i].coef = coef2 + i * n;
 		constraints2[i].rhs = (constraints + i)->rhs;
 		constraints2[i].type = (constraints + i)->type;
 	}
 	for (j = 0; j < n; j++) {
-		lp_transf_0(objective, constraints, bounds, m, _N, j, &ctr_var, &ctr_ubcons, obj2, coef2, constraints2);
-		lp_transf_1(objective, constraints, bounds, m, _N, j, &ctr_var, obj2, coef2);
-		lp_transf_2(objective, constraints, bounds, m, _M, j, obj2, obj_diff, constraints2);
+		lp_transf_0(objective, constraints, bounds, m, n, j, obj2, lb2, ub2, coef2);
+		lp_transf_2(objective, constraints, bounds, m, j, obj_diff, constraints2);
 	}
 }
 
@@ -168,36 +108,144 @@ static void lp_transstd(const double *objective, const struct optm_LinearConstra
 static void retreive_ori_lp_sol(const struct optm_VariableBound *bounds, const int n,
 				const double *x2, const double value2, const double obj_diff, double *x, double *value)
 {
-	int ctr_var;
 	int j;
 
-	ctr_var = 0;
-
 	for (j = 0; j < n; j++) {
 		const struct optm_VariableBound *bd = bounds + j;
 
-		if (optm_BOUND_T_FR == bd->b_type) {
-			x[j] = x2[ctr_var] - x2[ctr_var + 1];
-			ctr_var++;
-		} else if (optm_BOUND_T_LO == bd->b_type || optm_BOUND_T_BS == bd->b_type) {
-			x[j] = x2[ctr_var] + bd->lb;
-		} else {
-			x[j] = x2[ctr_var];
-		}
-		ctr_var++;
+		if (optm_BOUND_T_LO == bd->b_type || optm_BOUND_T_BS == bd->b_type)
+			x[j] = x2[j] + bd->lb;
+		else
+			x[j] = x2[j];
 	}
 	*value = value2 + obj_diff;
 }
 
-int lp_simplex(const double *objective, const struct optm_LinearConstraint *constraints,
+/* Check whether the bounds of some variable admit no value
+ */
+static int lp_bounds_crossed(const struct optm_VariableBound *bounds, const int n)
+{
+	int j;
+
+	for (j = 0; j < n; j++) {
+		if (bounds[j].b_type == optm_BOUND_T_UP && bounds[j].ub < 0.)
+			return 1;
+		if (bounds[j].b_type == optm_BOUND_T_BS && bounds[j].ub < bounds[j].lb)
+			return 1;
+	}
+	return 0;
+}
+
+/* Solve the reduced LP of the presolve and map its solution back
+ */
+static int presolve_opt(const double *objective, const struct optm_LinearConstraint *constraints,
+			const struct optm_VariableBound *bounds,
+			const int m, const int n, const char *criteria, const int niter,
+			const struct lp_simplex_Options *opts,
+			double *x, double *value, int *code)
+{
+	struct lp_simplex_Presolve *ps;
+	const struct lp_Model *md;
+	struct lp_simplex_Options opts2 = *opts;
+	double *x2, value2;
+	int j;
+
+	ps = lp_simplex_presolve(objective, constraints, bounds, m, n, code);
+	if (ps == NULL)
+		return lp_simplex_EXIT_FAILURE; /* error code already updated */
+	md = lp_simplex_presolve_model(ps);
+	x2 = (double *)lp_simplex_malloc((md->n + 1) * sizeof(double));
+	if (x2 == NULL) {
+		lp_simplex_presolve_free(ps);
+		*code = lp_simplex_MemoryAllocError;
+		return lp_simplex_EXIT_FAILURE;
+	}
+	opts2.presolve = 0;
+	if (md->m > 0 && lp_simplex_opt(md->objective, md->constraints, md->bounds, md->m, md->n,
+					criteria, niter, &opts2, x2, &value2, code) == lp_simplex_EXIT_FAILURE) {
+		lp_simplex_free(x2);
+		lp_simplex_presolve_free(ps);
+		return lp_simplex_EXIT_FAILURE; /* error code already updated */
+	}
+	lp_simplex_postsolve(ps, x2, x);
+	*value = 0.;
+	for (j = 0; j < n; j++)
+		*value += objective[j] * x[j];
+	lp_simplex_free(x2);
+	lp_simplex_presolve_free(ps);
+	*code = lp_simplex_Success;
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+/* Solve the scaled LP (see `lp_simplex_scale`) and unscale its solution
+ */
+static int scaling_opt(const double *objective, const struct optm_LinearConstraint *constraints,
+			const struct optm_VariableBound *bounds,
+			const int m, const int n, const char *criteria, const int niter,
+			const struct lp_simplex_Options *opts,
+			double *x, double *value, int *code)
+{
+	double *obj2, *x2, *rs, *cs, *coef2;
+	struct optm_LinearConstraint *constraints2;
+	struct optm_VariableBound *bounds2 = NULL;
+	struct lp_simplex_Options opts2 = *opts;
+	int i, j, state = lp_simplex_EXIT_FAILURE;
+
+	obj2 = lp_simplex_malloc((n + 1) * sizeof(double));
+	x2 = lp_simplex_malloc((n + 1) * sizeof(double));
+	cs = lp_simplex_malloc((n + 1) * sizeof(double));
+	rs = lp_simplex_malloc((m + 1) * sizeof(double));
+	coef2 = lp_simplex_malloc(((size_t)m * n + 1) * sizeof(double));
+	constraints2 = lp_simplex_malloc((m + 1) * sizeof(struct optm_LinearConstraint));
+	if (bounds != NULL)
+		bounds2 = lp_simplex_malloc(n * sizeof(struct optm_VariableBound));
+	if (!obj2 || !x2 || !cs || !rs || !coef2 || !constraints2 || (bounds != NULL && bounds2 == NULL)
+	    || lp_simplex_scale(constraints, m, n, rs, cs) == lp_simplex_EXIT_FAILURE) {
+		*code = lp_simplex_MemoryAllocError;
+		goto END;
+	}
+	for (i = 0; i < m; i++) {
+		constraints2[i] = constraints[i];
+		constraints2[i].coef = coef2 + i * n;
+		constraints2[i].rhs = constraints[i].rhs * rs[i];
+		for (j = 0; j < n; j++)
+			coef2[j + i * n] = constraints[i].coef[j] * rs[i] * cs[j];
+	}
+	for (j = 0; j < n; j++) {
+		obj2[j] = objective[j] * cs[j];
+		if (bounds2 == NULL)
+			continue;
+		bounds2[j] = bounds[j];
+		bounds2[j].lb = bounds[j].lb / cs[j];
+		bounds2[j].ub = bounds[j].ub / cs[j];
+	}
+	opts2.scaling = 0;
+	state = lp_simplex_opt(obj2, constraints2, bounds2, m, n, criteria, niter, &opts2, x2, value, code);
+	if (state == lp_simplex_EXIT_SUCCESS) {
+		for (j = 0; j < n; j++)
+			x[j] = x2[j] * cs[j];
+	}
+END:
+	lp_simplex_free(obj2);
+	lp_simplex_free(x2);
+	lp_simplex_free(cs);
+	lp_simplex_free(rs);
+	lp_simplex_free(coef2);
+	lp_simplex_free(constraints2);
+	lp_simplex_free(bounds2);
+	return state; /* error code already updated */
+}
+
+int lp_simplex_opt(const double *objective, const struct optm_LinearConstraint *constraints,
 		const struct optm_VariableBound *bounds,
 		const int m, const int n, const char *criteria, const int niter,
+		const struct lp_simplex_Options *opts,
 		double *x, double *value, int *code)
 {
-	int _M, _N;
-	double *obj2, *x2, *coef2;
+	double *obj2, *x2, *bnd2, *coef2;
 	struct optm_LinearConstraint *constraints2;
 	double value2 = 0, obj_diff = 0; /* value = value2 + obj_diff */
+	struct lp_simplex_Workspace *ws = opts ? opts->workspace : NULL;
 
 	assert(objective != NULL);
 	assert(constraints != NULL);
@@ -205,26 +253,43 @@ int lp_simplex(const double *objective, const struct optm_LinearConstraint *cons
 	assert(value != NULL);
 	assert(code != NULL);
 
+	if (bounds != NULL && lp_bounds_crossed(bounds, n)) {
+		*code = lp_simplex_Infeasibility;
+		return lp_simplex_EXIT_FAILURE;
+	}
+	if (opts != NULL && opts->presolve)
+		return presolve_opt(objective, constraints, bounds, m, n, criteria, niter, opts, x, value, code);
+	if (opts != NULL && opts->scaling)
+		return scaling_opt(objective, constraints, bounds, m, n, criteria, niter, opts, x, value, code);
 	if (bounds == NULL)
-		return lp_simplex_std(objective, constraints, m, n, criteria, niter, x, value, code);
-	stdlpf_size(bounds, m, n, &_M, &_N);
-
-	if (stdlpf_alloc(_M, _N, &obj2, &x2, &coef2, &constraints2) == lp_simplex_EXIT_FAILURE) {
+		return lp_simplex_std_bnd(objective, constraints, NULL, NULL, m, n, criteria, niter, opts,
+					  x, value, code);
+	if (7 == lp_simplex_strlen(criteria) && 0 == lp_simplex_memcmp("revised", criteria, 7))
+		return lp_simplex_rev(objective, constraints, bounds, m, n, niter, x, value, code);
+	if (stdlpf_alloc(ws, m, n, &obj2, &x2, &bnd2, &coef2, &constraints2) == lp_simplex_EXIT_FAILURE) {
 		*code = lp_simplex_MemoryAllocError;
 		return lp_simplex_EXIT_FAILURE;
 	}
-	lp_simplex_memset(coef2, 0., _M * _N);
-	lp_transstd(objective, constraints, bounds, m, n, _M, _N, obj2, &obj_diff, coef2, constraints2);
-	if (lp_simplex_std(obj2, constraints2, _M, _N, criteria, niter, x2, &value2, code) == lp_simplex_EXIT_SUCCESS) {
+	lp_transstd(objective, constraints, bounds, m, n, obj2, &obj_diff, bnd2, bnd2 + n, coef2, constraints2);
+	if (lp_simplex_std_bnd(obj2, constraints2, bnd2, bnd2 + n, m, n, criteria, niter, opts, x2, &value2, code)
+	    == lp_simplex_EXIT_SUCCESS) {
 		retreive_ori_lp_sol(bounds, n, x2, value2, obj_diff, x, value);
-		stdlpf_free(obj2, x2, coef2, constraints2);
+		stdlpf_free(ws, obj2, x2, bnd2, coef2, constraints2);
 		*code = lp_simplex_Success;
 		return lp_simplex_EXIT_SUCCESS;
 	}
-	stdlpf_free(obj2, x2, coef2, constraints2);
+	stdlpf_free(ws, obj2, x2, bnd2, coef2, constraints2);
 	return lp_simplex_EXIT_FAILURE; /* error code already updated */
 }
 
+int lp_simplex(const double *objective, const struct optm_LinearConstraint *constraints,
+		const struct optm_VariableBound *bounds,
+		const int m, const int n, const char *criteria, const int niter,
+		double *x, double *value, int *code)
+{
+	return lp_simplex_opt(objective, constraints, bounds, m, n, criteria, niter, NULL, x, value, code);
+}
+
 int lp_simplex_wrp(const struct lp_Model *model, const char *criteria, const int niter,
 			double *x, double *value, int *code)
 {
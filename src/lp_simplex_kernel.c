@@ -0,0 +1,523 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex_utils.h>
+#include <lp_simplex/lp_simplex.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define __lp_simplex_SIMD_X86__
+#include <immintrin.h>
+#endif
+
+/* Width (in doubles) of the column tiles of the rank-1 update: a tile of
+ * row p (4 KB) stays in L1 while it is added to every other row
+ */
+#define __lp_simplex_KERNEL_TILE__		512
+
+/* Kernels of one instruction set
+ *
+ * Products and sums are rounded separately (no FMA), so every instruction
+ * set gives the same bits as the scalar loop. Reductions return the same
+ * element as the scalar loop (the first one on ties; NaN is skipped).
+ */
+struct kernel_Isa {
+	const char *name;
+	void (*scale)(double *y, const double a, const int len);
+	void (*axpy)(double *y, const double *x, const double a, const int len);
+	int (*any_above)(const double *x, const double tol, const int len);
+	double (*max_at)(const double *x, const int *idx, const double floor, const int len);
+	double (*maxabs)(const double *x, const int len);
+	double (*maxabs_gap)(const double *x, const double *y, const int len);
+};
+
+static void scale_scalar(double *y, const double a, const int len)
+{
+	int j;
+
+	for (j = 0; j < len; j++)
+		y[j] *= a;
+}
+
+static void axpy_scalar(double *y, const double *x, const double a, const int len)
+{
+	int j;
+
+	for (j = 0; j < len; j++)
+		y[j] += a * x[j];
+}
+
+static int any_above_scalar(const double *x, const double tol, const int len)
+{
+	int j;
+
+	for (j = 0; j < len; j++) {
+		if (x[j] > tol)
+			return 1;
+	}
+	return 0;
+}
+
+static double max_at_scalar(const double *x, const int *idx, const double floor, const int len)
+{
+	int k;
+	double maxv = floor;
+
+	for (k = 0; k < len; k++) {
+		if (x[idx[k]] > maxv)
+			maxv = x[idx[k]];
+	}
+	return maxv;
+}
+
+static double maxabs_scalar(const double *x, const int len)
+{
+	int j;
+	double maxv = __lp_simplex_NINF__;
+
+	for (j = 0; j < len; j++) {
+		if (__lp_simplex_ABS__(x[j]) > maxv)
+			maxv = __lp_simplex_ABS__(x[j]);
+	}
+	return maxv;
+}
+
+static double maxabs_gap_scalar(const double *x, const double *y, const int len)
+{
+	int j;
+	double maxv = __lp_simplex_NINF__;
+
+	for (j = 0; j < len; j++) {
+		if (__lp_simplex_ABS__(x[j] - y[j]) > maxv)
+			maxv = __lp_simplex_ABS__(x[j] - y[j]);
+	}
+	return maxv;
+}
+
+#if USE_BLAS
+/* BLAS row operations, the fallback when the CPU has no SIMD variant
+ * (rounded by the BLAS library, so equal to the scalar loops up to rounding)
+ */
+static void scale_blas(double *y, const double a, const int len)
+{
+	lp_simplex_linalg_dscal(len, a, y, 1);
+}
+
+static void axpy_blas(double *y, const double *x, const double a, const int len)
+{
+	lp_simplex_linalg_daxpy(len, a, (double *)x, 1, y, 1);
+}
+#endif /* USE_BLAS */
+
+#ifdef __lp_simplex_SIMD_X86__
+
+/* Horizontal max of the lanes stored in `lane` (none is NaN) */
+static double lanes_max(const double *lane, const int nlane, double maxv)
+{
+	int k;
+
+	for (k = 0; k < nlane; k++) {
+		if (lane[k] > maxv)
+			maxv = lane[k];
+	}
+	return maxv;
+}
+
+/* `_mm*_max_pd(v, acc)` returns `acc` where `v` is NaN, as the scalar
+ * comparison does; |v| clears the sign bit.
+ */
+
+__attribute__((target("sse2")))
+static void scale_sse2(double *y, const double a, const int len)
+{
+	int j;
+	__m128d va = _mm_set1_pd(a);
+
+	for (j = 0; j + 2 <= len; j += 2)
+		_mm_storeu_pd(y + j, _mm_mul_pd(_mm_loadu_pd(y + j), va));
+	for (; j < len; j++)
+		y[j] *= a;
+}
+
+__attribute__((target("sse2")))
+static void axpy_sse2(double *y, const double *x, const double a, const int len)
+{
+	int j;
+	__m128d va = _mm_set1_pd(a);
+
+	for (j = 0; j + 2 <= len; j += 2)
+		_mm_storeu_pd(y + j, _mm_add_pd(_mm_loadu_pd(y + j), _mm_mul_pd(va, _mm_loadu_pd(x + j))));
+	for (; j < len; j++)
+		y[j] += a * x[j];
+}
+
+__attribute__((target("sse2")))
+static int any_above_sse2(const double *x, const double tol, const int len)
+{
+	int j;
+	__m128d vt = _mm_set1_pd(tol);
+
+	for (j = 0; j + 2 <= len; j += 2) {
+		if (_mm_movemask_pd(_mm_cmpgt_pd(_mm_loadu_pd(x + j), vt)))
+			return 1;
+	}
+	return any_above_scalar(x + j, tol, len - j);
+}
+
+__attribute__((target("sse2")))
+static double maxabs_sse2(const double *x, const int len)
+{
+	int j;
+	double lane[2];
+	__m128d sign = _mm_set1_pd(-0.), acc = _mm_set1_pd(__lp_simplex_NINF__);
+
+	for (j = 0; j + 2 <= len; j += 2)
+		acc = _mm_max_pd(_mm_andnot_pd(sign, _mm_loadu_pd(x + j)), acc);
+	_mm_storeu_pd(lane, acc);
+	return lanes_max(lane, 2, maxabs_scalar(x + j, len - j));
+}
+
+__attribute__((target("sse2")))
+static double maxabs_gap_sse2(const double *x, const double *y, const int len)
+{
+	int j;
+	double lane[2];
+	__m128d sign = _mm_set1_pd(-0.), acc = _mm_set1_pd(__lp_simplex_NINF__);
+
+	for (j = 0; j + 2 <= len; j += 2) {
+		__m128d d = _mm_sub_pd(_mm_loadu_pd(x + j), _mm_loadu_pd(y + j));
+
+		acc = _mm_max_pd(_mm_andnot_pd(sign, d), acc);
+	}
+	_mm_storeu_pd(lane, acc);
+	return lanes_max(lane, 2, maxabs_gap_scalar(x + j, y + j, len - j));
+}
+
+__attribute__((target("avx2")))
+static void scale_avx2(double *y, const double a, const int len)
+{
+	int j;
+	__m256d va = _mm256_set1_pd(a);
+
+	for (j = 0; j + 4 <= len; j += 4)
+		_mm256_storeu_pd(y + j, _mm256_mul_pd(_mm256_loadu_pd(y + j), va));
+	for (; j < len; j++)
+		y[j] *= a;
+}
+
+__attribute__((target("avx2")))
+static void axpy_avx2(double *y, const double *x, const double a, const int len)
+{
+	int j;
+	__m256d va = _mm256_set1_pd(a);
+
+	for (j = 0; j + 8 <= len; j += 8) {
+		__m256d x0 = _mm256_mul_pd(va, _mm256_loadu_pd(x + j));
+		__m256d x1 = _mm256_mul_pd(va, _mm256_loadu_pd(x + j + 4));
+
+		_mm256_storeu_pd(y + j, _mm256_add_pd(_mm256_loadu_pd(y + j), x0));
+		_mm256_storeu_pd(y + j + 4, _mm256_add_pd(_mm256_loadu_pd(y + j + 4), x1));
+	}
+	for (; j < len; j++)
+		y[j] += a * x[j];
+}
+
+__attribute__((target("avx2")))
+static int any_above_avx2(const double *x, const double tol, const int len)
+{
+	int j;
+	__m256d vt = _mm256_set1_pd(tol);
+
+	for (j = 0; j + 4 <= len; j += 4) {
+		if (_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(x + j), vt, _CMP_GT_OQ)))
+			return 1;
+	}
+	return any_above_scalar(x + j, tol, len - j);
+}
+
+__attribute__((target("avx2")))
+static double max_at_avx2(const double *x, const int *idx, const double floor, const int len)
+{
+	int k;
+	double lane[4];
+	__m256d acc = _mm256_set1_pd(floor);
+
+	for (k = 0; k + 4 <= len; k += 4) {
+		__m128i vi = _mm_loadu_si128((const __m128i *)(idx + k));
+
+		acc = _mm256_max_pd(_mm256_i32gather_pd(x, vi, 8), acc);
+	}
+	_mm256_storeu_pd(lane, acc);
+	return lanes_max(lane, 4, max_at_scalar(x, idx + k, floor, len - k));
+}
+
+__attribute__((target("avx2")))
+static double maxabs_avx2(const double *x, const int len)
+{
+	int j;
+	double lane[4];
+	__m256d sign = _mm256_set1_pd(-0.), acc = _mm256_set1_pd(__lp_simplex_NINF__);
+
+	for (j = 0; j + 4 <= len; j += 4)
+		acc = _mm256_max_pd(_mm256_andnot_pd(sign, _mm256_loadu_pd(x + j)), acc);
+	_mm256_storeu_pd(lane, acc);
+	return lanes_max(lane, 4, maxabs_scalar(x + j, len - j));
+}
+
+__attribute__((target("avx2")))
+static double maxabs_gap_avx2(const double *x, const double *y, const int len)
+{
+	int j;
+	double lane[4];
+	__m256d sign = _mm256_set1_pd(-0.), acc = _mm256_set1_pd(__lp_simplex_NINF__);
+
+	for (j = 0; j + 4 <= len; j += 4) {
+		__m256d d = _mm256_sub_pd(_mm256_loadu_pd(x + j), _mm256_loadu_pd(y + j));
+
+		acc = _mm256_max_pd(_mm256_andnot_pd(sign, d), acc);
+	}
+	_mm256_storeu_pd(lane, acc);
+	return lanes_max(lane, 4, maxabs_gap_scalar(x + j, y + j, len - j));
+}
+
+__attribute__((target("avx512f")))
+static void scale_avx512(double *y, const double a, const int len)
+{
+	int j;
+	__m512d va = _mm512_set1_pd(a);
+
+	for (j = 0; j + 8 <= len; j += 8)
+		_mm512_storeu_pd(y + j, _mm512_mul_pd(_mm512_loadu_pd(y + j), va));
+	for (; j < len; j++)
+		y[j] *= a;
+}
+
+__attribute__((target("avx512f")))
+static void axpy_avx512(double *y, const double *x, const double a, const int len)
+{
+	int j;
+	__m512d va = _mm512_set1_pd(a);
+
+	for (j = 0; j + 16 <= len; j += 16) {
+		__m512d x0 = _mm512_mul_pd(va, _mm512_loadu_pd(x + j));
+		__m512d x1 = _mm512_mul_pd(va, _mm512_loadu_pd(x + j + 8));
+
+		_mm512_storeu_pd(y + j, _mm512_add_pd(_mm512_loadu_pd(y + j), x0));
+		_mm512_storeu_pd(y + j + 8, _mm512_add_pd(_mm512_loadu_pd(y + j + 8), x1));
+	}
+	for (; j < len; j++)
+		y[j] += a * x[j];
+}
+
+__attribute__((target("avx512f")))
+static int any_above_avx512(const double *x, const double tol, const int len)
+{
+	int j;
+	__m512d vt = _mm512_set1_pd(tol);
+
+	for (j = 0; j + 8 <= len; j += 8) {
+		if (_mm512_cmp_pd_mask(_mm512_loadu_pd(x + j), vt, _CMP_GT_OQ))
+			return 1;
+	}
+	return any_above_scalar(x + j, tol, len - j);
+}
+
+__attribute__((target("avx512f")))
+static double max_at_avx512(const double *x, const int *idx, const double floor, const int len)
+{
+	int k;
+	double lane[8];
+	__m512d acc = _mm512_set1_pd(floor);
+
+	for (k = 0; k + 8 <= len; k += 8) {
+		__m256i vi = _mm256_loadu_si256((const __m256i *)(idx + k));
+
+		acc = _mm512_max_pd(_mm512_i32gather_pd(vi, x, 8), acc);
+	}
+	_mm512_storeu_pd(lane, acc);
+	return lanes_max(lane, 8, max_at_scalar(x, idx + k, floor, len - k));
+}
+
+__attribute__((target("avx512f")))
+static double maxabs_avx512(const double *x, const int len)
+{
+	int j;
+	double lane[8];
+	__m512d acc = _mm512_set1_pd(__lp_simplex_NINF__);
+
+	for (j = 0; j + 8 <= len; j += 8)
+		acc = _mm512_max_pd(_mm512_abs_pd(_mm512_loadu_pd(x + j)), acc);
+	_mm512_storeu_pd(lane, acc);
+	return lanes_max(lane, 8, maxabs_scalar(x + j, len - j));
+}
+
+__attribute__((target("avx512f")))
+static double maxabs_gap_avx512(const double *x, const double *y, const int len)
+{
+	int j;
+	double lane[8];
+	__m512d acc = _mm512_set1_pd(__lp_simplex_NINF__);
+
+	for (j = 0; j + 8 <= len; j += 8) {
+		__m512d d = _mm512_sub_pd(_mm512_loadu_pd(x + j), _mm512_loadu_pd(y + j));
+
+		acc = _mm512_max_pd(_mm512_abs_pd(d), acc);
+	}
+	_mm512_storeu_pd(lane, acc);
+	return lanes_max(lane, 8, maxabs_gap_scalar(x + j, y + j, len - j));
+}
+
+#endif /* __lp_simplex_SIMD_X86__ */
+
+static const struct kernel_Isa kernel_isas[] = {
+#ifdef __lp_simplex_SIMD_X86__
+	{ "avx512", scale_avx512, axpy_avx512, any_above_avx512, max_at_avx512, maxabs_avx512, maxabs_gap_avx512 },
+	{ "avx2", scale_avx2, axpy_avx2, any_above_avx2, max_at_avx2, maxabs_avx2, maxabs_gap_avx2 },
+	{ "sse2", scale_sse2, axpy_sse2, any_above_sse2, max_at_scalar, maxabs_sse2, maxabs_gap_sse2 },
+#endif
+#if USE_BLAS
+	{ "blas", scale_blas, axpy_blas, any_above_scalar, max_at_scalar, maxabs_scalar, maxabs_gap_scalar },
+#endif
+	{ "scalar", scale_scalar, axpy_scalar, any_above_scalar, max_at_scalar, maxabs_scalar, maxabs_gap_scalar }
+};
+
+#define __lp_simplex_KERNEL_NISA__ ((int)(sizeof(kernel_isas) / sizeof(kernel_isas[0])))
+
+static const struct kernel_Isa *kernel = NULL;
+
+static int kernel_supported(const struct kernel_Isa *isa)
+{
+#ifdef __lp_simplex_SIMD_X86__
+	if (isa->axpy == axpy_avx512)
+		return __builtin_cpu_supports("avx512f");
+	if (isa->axpy == axpy_avx2)
+		return __builtin_cpu_supports("avx2");
+	if (isa->axpy == axpy_sse2)
+		return __builtin_cpu_supports("sse2");
+#endif
+	(void) isa;
+	return 1;
+}
+
+/* Pick the widest instruction set supported by the CPU (on first use)
+ */
+static const struct kernel_Isa *kernel_get(void)
+{
+	int k;
+
+	if (kernel == NULL) {
+		for (k = 0; k < __lp_simplex_KERNEL_NISA__; k++) {
+			if (kernel_supported(kernel_isas + k)) {
+				kernel = kernel_isas + k;
+				break;
+			}
+		}
+	}
+	return kernel;
+}
+
+const char *lp_simplex_kernel_isa(void)
+{
+	return kernel_get()->name;
+}
+
+int lp_simplex_kernel_use(const char *isa)
+{
+	int k;
+
+	for (k = 0; k < __lp_simplex_KERNEL_NISA__; k++) {
+		if (lp_simplex_strlen(isa) == lp_simplex_strlen(kernel_isas[k].name)
+		    && 0 == lp_simplex_memcmp(isa, kernel_isas[k].name, lp_simplex_strlen(isa))) {
+			if (!kernel_supported(kernel_isas + k))
+				return lp_simplex_EXIT_FAILURE;
+			kernel = kernel_isas + k;
+			return lp_simplex_EXIT_SUCCESS;
+		}
+	}
+	return lp_simplex_EXIT_FAILURE;
+}
+
+void lp_simplex_kernel_scale(double *row, const double a, const int len)
+{
+	kernel_get()->scale(row, a, len);
+}
+
+int lp_simplex_kernel_any_above(const double *x, const double tol, const int len)
+{
+	return kernel_get()->any_above(x, tol, len);
+}
+
+int lp_simplex_kernel_argmax_at(const double *x, const int *idx, const double floor, const int len)
+{
+	int k;
+	double maxv = kernel_get()->max_at(x, idx, floor, len);
+
+	if (maxv <= floor)
+		return len;
+	for (k = 0; x[idx[k]] != maxv; k++)  /* first position holding the max */
+		;
+	return k;
+}
+
+int lp_simplex_kernel_argmaxabs(const double *x, const int len)
+{
+	int j;
+	double maxv = kernel_get()->maxabs(x, len);
+
+	for (j = 0; j < len; j++) {
+		if (__lp_simplex_ABS__(x[j]) == maxv)
+			return j;
+	}
+	return 0;
+}
+
+double lp_simplex_kernel_maxabs(const double *x, const int len)
+{
+	return kernel_get()->maxabs(x, len);
+}
+
+double lp_simplex_kernel_maxabs_gap(const double *x, const double *y, const int len)
+{
+	return kernel_get()->maxabs_gap(x, y, len);
+}
+
+/* One column tile [jb, jb + len) of every row in [begin, end) except p
+ */
+static void kernel_rank1_tile(const struct kernel_Isa *isa, double *table, const int ldtable,
+				const int p, const int q, const int begin, const int end,
+				const int jb, const int len)
+{
+	int i;
+	const double *rowp = table + p * ldtable + jb;
+
+	for (i = begin; i < end; i++) {
+		double a = -table[q + i * ldtable];
+
+		if (i == p || a == 0.)
+			continue;
+		isa->axpy(table + i * ldtable + jb, rowp, a, len);
+	}
+}
+
+void lp_simplex_kernel_rank1(double *table, const int ldtable, const int ncol,
+				const int p, const int q, const int begin, const int end)
+{
+	const struct kernel_Isa *isa = kernel_get();
+	int jb, tile = __lp_simplex_KERNEL_TILE__;
+	int qb;
+
+#if USE_BLAS
+	if (isa->axpy == axpy_blas)  /* one BLAS call per row */
+		tile = __lp_simplex_MAX__(ncol, 1);
+#endif
+	qb = q / tile * tile;  /* the tile holding column q goes last */
+
+	for (jb = 0; jb < ncol; jb += tile) {
+		if (jb != qb)
+			kernel_rank1_tile(isa, table, ldtable, p, q, begin, end, jb,
+					  __lp_simplex_MIN__(tile, ncol - jb));
+	}
+	if (qb < ncol)
+		kernel_rank1_tile(isa, table, ldtable, p, q, begin, end, qb,
+				  __lp_simplex_MIN__(tile, ncol - qb));
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#ifdef USE_PTHREAD
+#define _POSIX_C_SOURCE 200112L
+#include <pthread.h>
+#endif
+#include <lp_simplex/lp_simplex.h>
+
+#ifdef USE_PTHREAD
+
+/* Workers sleep on `start` between tasks; `generation` is bumped once per
+ * `lp_simplex_pool_run` so that a worker runs every task exactly once.
+ * The caller takes part as worker 0 and waits on `done` for the others.
+ */
+struct lp_simplex_Pool {
+	int nthreads;
+	pthread_t *threads;
+	pthread_mutex_t lock;
+	pthread_cond_t start;
+	pthread_cond_t done;
+	unsigned long generation;
+	int pending;
+	int quit;
+	void (*task)(void *arg, const int id, const int nworkers);
+	void *arg;
+};
+
+struct pool_Worker {
+	struct lp_simplex_Pool *pool;
+	int id;
+};
+
+static void *pool_worker_main(void *data)
+{
+	struct lp_simplex_Pool *pool = ((struct pool_Worker *) data)->pool;
+	int id = ((struct pool_Worker *) data)->id;
+	unsigned long seen = 0;
+
+	lp_simplex_free(data);
+	for (;;) {
+		void (*task)(void *, const int, const int);
+		void *arg;
+
+		pthread_mutex_lock(&pool->lock);
+		while (pool->generation == seen && !pool->quit)
+			pthread_cond_wait(&pool->start, &pool->lock);
+		if (pool->quit) {
+			pthread_mutex_unlock(&pool->lock);
+			return NULL;
+		}
+		seen = pool->generation;
+		task = pool->task;
+		arg = pool->arg;
+		pthread_mutex_unlock(&pool->lock);
+
+		task(arg, id, pool->nthreads);
+
+		pthread_mutex_lock(&pool->lock);
+		if (--pool->pending == 0)
+			pthread_cond_signal(&pool->done);
+		pthread_mutex_unlock(&pool->lock);
+	}
+}
+
+static void pool_stop(struct lp_simplex_Pool *pool, const int nstarted)
+{
+	int k;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->quit = 1;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->lock);
+	for (k = 0; k < nstarted; k++)
+		pthread_join(pool->threads[k], NULL);
+	pthread_cond_destroy(&pool->done);
+	pthread_cond_destroy(&pool->start);
+	pthread_mutex_destroy(&pool->lock);
+	lp_simplex_free(pool->threads);
+	lp_simplex_free(pool);
+}
+
+struct lp_simplex_Pool *lp_simplex_pool_create(const int nthreads)
+{
+	struct lp_simplex_Pool *pool;
+	int k;
+
+	if (nthreads <= 1)
+		return NULL;
+	lp_simplex_kernel_isa();  /* pick the kernels before any worker uses them */
+	pool = lp_simplex_malloc(sizeof(struct lp_simplex_Pool));
+	if (pool == NULL)
+		return NULL;
+	pool->threads = lp_simplex_malloc((nthreads - 1) * sizeof(pthread_t));
+	if (pool->threads == NULL) {
+		lp_simplex_free(pool);
+		return NULL;
+	}
+	pool->nthreads = nthreads;
+	pool->generation = 0;
+	pool->pending = 0;
+	pool->quit = 0;
+	pool->task = NULL;
+	pool->arg = NULL;
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->start, NULL);
+	pthread_cond_init(&pool->done, NULL);
+
+	for (k = 0; k < nthreads - 1; k++) {
+		struct pool_Worker *data = lp_simplex_malloc(sizeof(struct pool_Worker));
+
+		if (data == NULL)
+			goto FAIL;
+		data->pool = pool;
+		data->id = k + 1;
+		if (pthread_create(pool->threads + k, NULL, pool_worker_main, data) != 0) {
+			lp_simplex_free(data);
+			goto FAIL;
+		}
+	}
+	return pool;
+FAIL:
+	pool_stop(pool, k);
+	return NULL;
+}
+
+void lp_simplex_pool_free(struct lp_simplex_Pool *pool)
+{
+	if (pool)
+		pool_stop(pool, pool->nthreads - 1);
+}
+
+int lp_simplex_pool_size(const struct lp_simplex_Pool *pool)
+{
+	return pool ? pool->nthreads : 1;
+}
+
+void lp_simplex_pool_run(struct lp_simplex_Pool *pool,
+			void (*task)(void *arg, const int id, const int nworkers), void *arg)
+{
+	if (pool == NULL) {
+		task(arg, 0, 1);
+		return;
+	}
+	pthread_mutex_lock(&pool->lock);
+	pool->task = task;
+	pool->arg = arg;
+	pool->pending = pool->nthreads - 1;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->lock);
+
+	task(arg, 0, pool->nthreads);
+
+	pthread_mutex_lock(&pool->lock);
+	while (pool->pending > 0)
+		pthread_cond_wait(&pool->done, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+}
+
+#else
+
+struct lp_simplex_Pool *lp_simplex_pool_create(const int nthreads)
+{
+	(void) nthreads;
+	return NULL;
+}
+
+void lp_simplex_pool_free(struct lp_simplex_Pool *pool)
+{
+	(void) pool;
+}
+
+int lp_simplex_pool_size(const struct lp_simplex_Pool *pool)
+{
+	(void) pool;
+	return 1;
+}
+
+void lp_simplex_pool_run(struct lp_simplex_Pool *pool,
+			void (*task)(void *arg, const int id, const int nworkers), void *arg)
+{
+	(void) pool;
+	task(arg, 0, 1);
+}
+
+#endif /* USE_PTHREAD */
@@ -0,0 +1,684 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex_utils.h>
+#include <lp_simplex/lp_simplex.h>
+
+/* Feasibility tolerance of the reductions */
+#define __lp_simplex_PRESOLVE_TOL__		1e-9
+
+/* Coefficients below this magnitude after a substitution are dropped */
+#define __lp_simplex_PRESOLVE_DROP__		1e-12
+
+/* Postsolve records */
+#define __lp_simplex_PRESOLVE_FIX__		0	/* x_j = value */
+#define __lp_simplex_PRESOLVE_SUBST__		1	/* a * x_j + row' x = value */
+#define __lp_simplex_PRESOLVE_SLACK__		2	/* lo <= a * x_j + row' x <= hi, lb <= x_j <= ub */
+
+struct presolve_Record {
+	int type;
+	int j;
+	double value;
+	double a;
+	double lo, hi;
+	double lb, ub;
+	int beg;		/* saved row (without x_j) in `rowidx` and `rowval` */
+	int len;
+};
+
+/* Working LP
+ *
+ *	min  c'x
+ *	s.t. rlo <= A x <= rup
+ *		lb <= x <= ub
+ *
+ * with A dense (row major); removed rows and columns are zeroed and
+ * flagged inactive. The reductions are recorded for postsolve, and the
+ * remaining LP is emitted as `model` in the form taken by `lp_simplex`.
+ */
+struct lp_simplex_Presolve {
+	int m;
+	int n;
+	double *a;
+	double *c;
+	double *rlo;
+	double *rup;
+	double *lb;
+	double *ub;
+	int *rowact;
+	int *colact;
+	int *rowcnt;
+	int *colcnt;
+	int nrec;
+	int reccap;
+	struct presolve_Record *rec;
+	int nsave;
+	int savecap;
+	int *rowidx;
+	double *rowval;
+	struct lp_Model *model;	/* reduced LP */
+	int *colmap;		/* original column of each reduced column (-1: slack) */
+	int *reflect;		/* reduced column holds -x_j */
+};
+
+void lp_simplex_presolve_free(struct lp_simplex_Presolve *ps)
+{
+	if (ps == NULL)
+		return;
+	lp_simplex_free(ps->a);
+	lp_simplex_free(ps->c);
+	lp_simplex_free(ps->rlo);
+	lp_simplex_free(ps->rup);
+	lp_simplex_free(ps->lb);
+	lp_simplex_free(ps->ub);
+	lp_simplex_free(ps->rowact);
+	lp_simplex_free(ps->colact);
+	lp_simplex_free(ps->rowcnt);
+	lp_simplex_free(ps->colcnt);
+	lp_simplex_free(ps->rec);
+	lp_simplex_free(ps->rowidx);
+	lp_simplex_free(ps->rowval);
+	lp_simplex_free(ps->colmap);
+	lp_simplex_free(ps->reflect);
+	lp_simplex_model_free(ps->model);
+	lp_simplex_free(ps);
+}
+
+static struct lp_simplex_Presolve *presolve_create(const double *objective,
+						const struct optm_LinearConstraint *constraints,
+						const struct optm_VariableBound *bounds, const int m, const int n)
+{
+	struct lp_simplex_Presolve *ps;
+	int i, j;
+
+	ps = (struct lp_simplex_Presolve *)lp_simplex_malloc(sizeof(struct lp_simplex_Presolve));
+	if (ps == NULL)
+		return NULL;
+	lp_simplex_memset(ps, 0, sizeof(struct lp_simplex_Presolve));
+	ps->a = (double *)lp_simplex_malloc(((size_t)m * n + 1) * sizeof(double));
+	ps->c = (double *)lp_simplex_malloc((n + 1) * sizeof(double));
+	ps->rlo = (double *)lp_simplex_malloc((m + 1) * sizeof(double));
+	ps->rup = (double *)lp_simplex_malloc((m + 1) * sizeof(double));
+	ps->lb = (double *)lp_simplex_malloc((n + 1) * sizeof(double));
+	ps->ub = (double *)lp_simplex_malloc((n + 1) * sizeof(double));
+	ps->rowact = (int *)lp_simplex_malloc((m + 1) * sizeof(int));
+	ps->colact = (int *)lp_simplex_malloc((n + 1) * sizeof(int));
+	ps->rowcnt = (int *)lp_simplex_malloc((m + 1) * sizeof(int));
+	ps->colcnt = (int *)lp_simplex_malloc((n + 1) * sizeof(int));
+	if (!ps->a || !ps->c || !ps->rlo || !ps->rup || !ps->lb || !ps->ub
+	    || !ps->rowact || !ps->colact || !ps->rowcnt || !ps->colcnt) {
+		lp_simplex_presolve_free(ps);
+		return NULL;
+	}
+	ps->m = m;
+	ps->n = n;
+	lp_simplex_memset(ps->rowcnt, 0, m * sizeof(int));
+	lp_simplex_memset(ps->colcnt, 0, n * sizeof(int));
+	for (j = 0; j < n; j++) {
+		ps->c[j] = objective[j];
+		ps->colact[j] = 1;
+		ps->lb[j] = 0.;
+		ps->ub[j] = __lp_simplex_INF__;
+		if (bounds == NULL)
+			continue;
+		switch (bounds[j].b_type) {
+		case optm_BOUND_T_FR:
+			ps->lb[j] = __lp_simplex_NINF__;
+			break;
+		case optm_BOUND_T_UP:
+			ps->ub[j] = bounds[j].ub;
+			break;
+		case optm_BOUND_T_LO:
+			ps->lb[j] = bounds[j].lb;
+			break;
+		case optm_BOUND_T_BS:
+			ps->lb[j] = bounds[j].lb;
+			ps->ub[j] = bounds[j].ub;
+			break;
+		}
+	}
+	for (i = 0; i < m; i++) {
+		ps->rowact[i] = 1;
+		ps->rlo[i] = constraints[i].type == optm_CONS_T_LE ? __lp_simplex_NINF__ : constraints[i].rhs;
+		ps->rup[i] = constraints[i].type == optm_CONS_T_GE ? __lp_simplex_INF__ : constraints[i].rhs;
+		for (j = 0; j < n; j++) {
+			double aij = constraints[i].coef[j];
+
+			ps->a[j + i * n] = aij;
+			if (aij != 0.) {
+				ps->rowcnt[i]++;
+				ps->colcnt[j]++;
+			}
+		}
+	}
+	return ps;
+}
+
+/* Set a_ij, keeping the counts of rows and columns
+ */
+static void presolve_set(struct lp_simplex_Presolve *ps, const int i, const int j, double v)
+{
+	double *aij = ps->a + j + i * ps->n;
+
+	if (__lp_simplex_ABS__(v) < __lp_simplex_PRESOLVE_DROP__)
+		v = 0.;
+	if (*aij == 0. && v != 0.) {
+		ps->rowcnt[i]++;
+		ps->colcnt[j]++;
+	} else if (*aij != 0. && v == 0.) {
+		ps->rowcnt[i]--;
+		ps->colcnt[j]--;
+	}
+	*aij = v;
+}
+
+static void presolve_drop_row(struct lp_simplex_Presolve *ps, const int i)
+{
+	int j;
+
+	for (j = 0; j < ps->n; j++)
+		presolve_set(ps, i, j, 0.);
+	ps->rowact[i] = 0;
+}
+
+static struct presolve_Record *presolve_push(struct lp_simplex_Presolve *ps, const int type, const int j)
+{
+	struct presolve_Record *r;
+
+	if (ps->nrec == ps->reccap) {
+		int cap = ps->reccap > 0 ? 2 * ps->reccap : 16;
+		void *tmp = lp_simplex_realloc(ps->rec, cap * sizeof(struct presolve_Record));
+
+		if (tmp == NULL)
+			return NULL;
+		ps->rec = (struct presolve_Record *)tmp;
+		ps->reccap = cap;
+	}
+	r = ps->rec + ps->nrec++;
+	lp_simplex_memset(r, 0, sizeof(struct presolve_Record));
+	r->type = type;
+	r->j = j;
+	return r;
+}
+
+/* Save row i without column j in the record `r`
+ */
+static int presolve_save_row(struct lp_simplex_Presolve *ps, struct presolve_Record *r, const int i, const int j)
+{
+	int k, n = ps->n;
+
+	if (ps->nsave + n > ps->savecap) {
+		int cap = __lp_simplex_MAX__(2 * ps->savecap, ps->nsave + n);
+		void *idx = lp_simplex_realloc(ps->rowidx, cap * sizeof(int));
+		void *val;
+
+		if (idx == NULL)
+			return lp_simplex_EXIT_FAILURE;
+		ps->rowidx = (int *)idx;
+		val = lp_simplex_realloc(ps->rowval, cap * sizeof(double));
+		if (val == NULL)
+			return lp_simplex_EXIT_FAILURE;
+		ps->rowval = (double *)val;
+		ps->savecap = cap;
+	}
+	r->beg = ps->nsave;
+	for (k = 0; k < n; k++) {
+		if (k != j && ps->a[k + i * n] != 0.) {
+			ps->rowidx[ps->nsave] = k;
+			ps->rowval[ps->nsave] = ps->a[k + i * n];
+			ps->nsave++;
+		}
+	}
+	r->len = ps->nsave - r->beg;
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+/* Fix x_j = v and move it into the row bounds
+ */
+static int presolve_fix(struct lp_simplex_Presolve *ps, const int j, const double v)
+{
+	int i;
+	struct presolve_Record *r = presolve_push(ps, __lp_simplex_PRESOLVE_FIX__, j);
+
+	if (r == NULL)
+		return lp_simplex_EXIT_FAILURE;
+	r->value = v;
+	for (i = 0; i < ps->m; i++) {
+		double aij = ps->a[j + i * ps->n];
+
+		if (aij == 0.)
+			continue;
+		ps->rlo[i] -= aij * v;
+		ps->rup[i] -= aij * v;
+		presolve_set(ps, i, j, 0.);
+	}
+	ps->colact[j] = 0;
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+/* Bounds [*lo, *hi] of the activity of row i without column `skip`
+ */
+static void presolve_activity(const struct lp_simplex_Presolve *ps, const int i, const int skip,
+				double *lo, double *hi)
+{
+	int j, n = ps->n;
+
+	*lo = 0.;
+	*hi = 0.;
+	for (j = 0; j < n; j++) {
+		double aij = ps->a[j + i * n];
+
+		if (aij == 0. || j == skip)
+			continue;
+		*lo += aij > 0. ? aij * ps->lb[j] : aij * ps->ub[j];
+		*hi += aij > 0. ? aij * ps->ub[j] : aij * ps->lb[j];
+	}
+}
+
+/* Range [*lo, *hi] of a * x for lb <= x <= ub
+ */
+static void presolve_range(const double a, const double lb, const double ub, double *lo, double *hi)
+{
+	*lo = a > 0. ? a * lb : a * ub;
+	*hi = a > 0. ? a * ub : a * lb;
+}
+
+/* Empty, singleton, doubleton, forcing and redundant rows
+ */
+static int presolve_row(struct lp_simplex_Presolve *ps, const int i, int *changed)
+{
+	int j, k = -1, l = -1, n = ps->n;
+	double lo, hi, tol = __lp_simplex_PRESOLVE_TOL__;
+	double *a = ps->a + i * n;
+
+	if (ps->rowcnt[i] <= 2) {
+		for (j = 0; j < n; j++) {
+			if (a[j] != 0.) {
+				if (k < 0)
+					k = j;
+				else
+					l = j;
+			}
+		}
+	}
+	if (ps->rowcnt[i] == 0) {  /* empty row */
+		if (ps->rlo[i] > tol || ps->rup[i] < -tol)
+			return lp_simplex_Infeasibility;
+		ps->rowact[i] = 0;
+		*changed = 1;
+		return lp_simplex_Success;
+	}
+	if (ps->rowcnt[i] == 1) {  /* singleton row: bounds of x_k */
+		if (a[k] > 0.) {
+			ps->lb[k] = __lp_simplex_MAX__(ps->lb[k], ps->rlo[i] / a[k]);
+			ps->ub[k] = __lp_simplex_MIN__(ps->ub[k], ps->rup[i] / a[k]);
+		} else {
+			ps->lb[k] = __lp_simplex_MAX__(ps->lb[k], ps->rup[i] / a[k]);
+			ps->ub[k] = __lp_simplex_MIN__(ps->ub[k], ps->rlo[i] / a[k]);
+		}
+		if (ps->lb[k] > ps->ub[k] + tol)
+			return lp_simplex_Infeasibility;
+		if (ps->lb[k] > ps->ub[k])
+			ps->ub[k] = ps->lb[k];
+		presolve_drop_row(ps, i);
+		*changed = 1;
+		return lp_simplex_Success;
+	}
+	if (ps->rowcnt[i] == 2 && ps->rlo[i] == ps->rup[i]) {  /* doubleton equation */
+		struct presolve_Record *r;
+		double ratio, shift, klo, khi;
+		int p;
+
+		if (__lp_simplex_ABS__(a[k]) > __lp_simplex_ABS__(a[l])) {  /* eliminate x_l, the larger pivot */
+			j = k;
+			k = l;
+			l = j;
+		}
+		j = k;  /* x_l = shift - ratio * x_j */
+		ratio = a[j] / a[l];
+		shift = ps->rlo[i] / a[l];
+		r = presolve_push(ps, __lp_simplex_PRESOLVE_SUBST__, l);
+		if (r == NULL || presolve_save_row(ps, r, i, l) == lp_simplex_EXIT_FAILURE)
+			return lp_simplex_MemoryAllocError;
+		r->a = a[l];
+		r->value = ps->rlo[i];
+		presolve_range(-1. / ratio, ps->lb[l] - shift, ps->ub[l] - shift, &klo, &khi);
+		ps->lb[j] = __lp_simplex_MAX__(ps->lb[j], klo);
+		ps->ub[j] = __lp_simplex_MIN__(ps->ub[j], khi);
+		if (ps->lb[j] > ps->ub[j] + tol)
+			return lp_simplex_Infeasibility;
+		if (ps->lb[j] > ps->ub[j])
+			ps->ub[j] = ps->lb[j];
+		ps->c[j] -= ps->c[l] * ratio;
+		presolve_drop_row(ps, i);
+		for (p = 0; p < ps->m; p++) {
+			double apl = ps->a[l + p * n];
+
+			if (apl == 0.)
+				continue;
+			presolve_set(ps, p, j, ps->a[j + p * n] - apl * ratio);
+			ps->rlo[p] -= apl * shift;
+			ps->rup[p] -= apl * shift;
+			presolve_set(ps, p, l, 0.);
+		}
+		ps->colact[l] = 0;
+		*changed = 1;
+		return lp_simplex_Success;
+	}
+	presolve_activity(ps, i, -1, &lo, &hi);
+	if (hi < ps->rlo[i] - tol || lo > ps->rup[i] + tol)
+		return lp_simplex_Infeasibility;
+	if (hi <= ps->rlo[i] + tol || lo >= ps->rup[i] - tol) {  /* forcing row */
+		int up = hi <= ps->rlo[i] + tol;
+
+		for (j = 0; j < n; j++) {
+			if (a[j] == 0.)
+				continue;
+			if (presolve_fix(ps, j, (a[j] > 0.) == up ? ps->ub[j] : ps->lb[j]) == lp_simplex_EXIT_FAILURE)
+				return lp_simplex_MemoryAllocError;
+		}
+		ps->rowact[i] = 0;
+		*changed = 1;
+		return lp_simplex_Success;
+	}
+	if (lo >= ps->rlo[i] && ps->rlo[i] > __lp_simplex_NINF__) {  /* redundant sides */
+		ps->rlo[i] = __lp_simplex_NINF__;
+		*changed = 1;
+	}
+	if (hi <= ps->rup[i] && ps->rup[i] < __lp_simplex_INF__) {
+		ps->rup[i] = __lp_simplex_INF__;
+		*changed = 1;
+	}
+	if (ps->rlo[i] == __lp_simplex_NINF__ && ps->rup[i] == __lp_simplex_INF__)
+		presolve_drop_row(ps, i);
+	return lp_simplex_Success;
+}
+
+/* Singleton column j in row i
+ *
+ * With c_j = 0 the column is a slack of the row, which takes the range of
+ * a_ij * x_j. Otherwise, if x_j is (implied) free, the row is tight at
+ * optimum on the side that c_j pushes it to, and x_j is substituted.
+ */
+static int presolve_col_singleton(struct lp_simplex_Presolve *ps, const int j, int *changed)
+{
+	int i, k, n = ps->n;
+	double aij = 0., lo, hi, t;
+	struct presolve_Record *r;
+
+	for (i = 0; i < ps->m; i++) {
+		aij = ps->a[j + i * n];
+		if (aij != 0.)
+			break;
+	}
+	if (ps->c[j] == 0.) {
+		r = presolve_push(ps, __lp_simplex_PRESOLVE_SLACK__, j);
+		if (r == NULL || presolve_save_row(ps, r, i, j) == lp_simplex_EXIT_FAILURE)
+			return lp_simplex_MemoryAllocError;
+		r->a = aij;
+		r->lo = ps->rlo[i];
+		r->hi = ps->rup[i];
+		r->lb = ps->lb[j];
+		r->ub = ps->ub[j];
+		presolve_range(aij, ps->lb[j], ps->ub[j], &lo, &hi);
+		ps->rlo[i] -= hi;
+		ps->rup[i] -= lo;
+		presolve_set(ps, i, j, 0.);
+		ps->colact[j] = 0;
+		*changed = 1;
+		return lp_simplex_Success;
+	}
+	presolve_activity(ps, i, j, &lo, &hi);  /* a_ij * x_j in [rlo - hi, rup - lo] */
+	presolve_range(1. / aij, ps->rlo[i] - hi, ps->rup[i] - lo, &lo, &hi);
+	if (lo < ps->lb[j] || hi > ps->ub[j])
+		return lp_simplex_Success;  /* not implied free */
+	t = ps->c[j] / aij > 0. ? ps->rlo[i] : ps->rup[i];
+	if (t == __lp_simplex_NINF__ || t == __lp_simplex_INF__)
+		return lp_simplex_Success;  /* left to the solver (unbounded if feasible) */
+	r = presolve_push(ps, __lp_simplex_PRESOLVE_SUBST__, j);
+	if (r == NULL || presolve_save_row(ps, r, i, j) == lp_simplex_EXIT_FAILURE)
+		return lp_simplex_MemoryAllocError;
+	r->a = aij;
+	r->value = t;
+	for (k = 0; k < n; k++) {
+		if (k != j)
+			ps->c[k] -= ps->c[j] * ps->a[k + i * n] / aij;
+	}
+	presolve_drop_row(ps, i);
+	ps->colact[j] = 0;
+	*changed = 1;
+	return lp_simplex_Success;
+}
+
+/* Fixed, empty, singleton and dominated columns
+ */
+static int presolve_col(struct lp_simplex_Presolve *ps, const int j, int *changed)
+{
+	int i, up = 1, down = 1;
+	double c = ps->c[j], v;
+
+	if (ps->ub[j] - ps->lb[j] <= __lp_simplex_PRESOLVE_TOL__) {  /* fixed */
+		*changed = 1;
+		return presolve_fix(ps, j, ps->lb[j]) == lp_simplex_EXIT_SUCCESS ?
+			lp_simplex_Success : lp_simplex_MemoryAllocError;
+	}
+	if (ps->colcnt[j] == 1)
+		return presolve_col_singleton(ps, j, changed);
+
+	/* up (down): increasing (decreasing) x_j never helps any row */
+	for (i = 0; i < ps->m && (up || down); i++) {
+		double aij = ps->a[j + i * ps->n];
+
+		if (aij == 0.)
+			continue;
+		if (aij > 0.) {
+			up = up && ps->rlo[i] == __lp_simplex_NINF__;
+			down = down && ps->rup[i] == __lp_simplex_INF__;
+		} else {
+			up = up && ps->rup[i] == __lp_simplex_INF__;
+			down = down && ps->rlo[i] == __lp_simplex_NINF__;
+		}
+	}
+	if (up && c >= 0. && ps->lb[j] > __lp_simplex_NINF__)
+		v = ps->lb[j];
+	else if (down && c <= 0. && ps->ub[j] < __lp_simplex_INF__)
+		v = ps->ub[j];
+	else if (ps->colcnt[j] == 0 && c == 0.)  /* empty and free of cost */
+		v = __lp_simplex_MIN__(__lp_simplex_MAX__(0., ps->lb[j]), ps->ub[j]);
+	else
+		return lp_simplex_Success;
+	*changed = 1;
+	return presolve_fix(ps, j, v) == lp_simplex_EXIT_SUCCESS ? lp_simplex_Success : lp_simplex_MemoryAllocError;
+}
+
+static int presolve_reduce(struct lp_simplex_Presolve *ps)
+{
+	int i, j, state, changed = 1;
+
+	for (j = 0; j < ps->n; j++) {
+		if (ps->lb[j] > ps->ub[j] + __lp_simplex_PRESOLVE_TOL__)  /* crossed bounds */
+			return lp_simplex_Infeasibility;
+	}
+	while (changed) {
+		changed = 0;
+		for (i = 0; i < ps->m; i++) {
+			if (ps->rowact[i] && (state = presolve_row(ps, i, &changed)) != lp_simplex_Success)
+				return state;
+		}
+		for (j = 0; j < ps->n; j++) {
+			if (ps->colact[j] && (state = presolve_col(ps, j, &changed)) != lp_simplex_Success)
+				return state;
+		}
+	}
+	return lp_simplex_Success;
+}
+
+/* Emit the remaining LP: a column bounded above only is reflected, and a
+ * ranged row gets a bounded slack column
+ */
+static int presolve_emit(struct lp_simplex_Presolve *ps)
+{
+	int i, j, k, m2 = 0, n2 = 0, nslack = 0, n = ps->n;
+	struct lp_Model *md;
+
+	for (i = 0; i < ps->m; i++) {
+		if (!ps->rowact[i])
+			continue;
+		m2++;
+		if (ps->rlo[i] > __lp_simplex_NINF__ && ps->rup[i] < __lp_simplex_INF__ && ps->rlo[i] != ps->rup[i])
+			nslack++;
+	}
+	for (j = 0; j < n; j++)
+		n2 += ps->colact[j];
+	n2 += nslack;
+	md = (struct lp_Model *)lp_simplex_malloc(sizeof(struct lp_Model));
+	if (md == NULL)
+		return lp_simplex_EXIT_FAILURE;
+	lp_simplex_memset(md, 0, sizeof(struct lp_Model));
+	ps->model = md;
+	md->m = m2;
+	md->n = n2;
+	md->objective = (double *)lp_simplex_malloc((n2 + 1) * sizeof(double));
+	md->coefficients = (double *)lp_simplex_malloc(((size_t)m2 * n2 + 1) * sizeof(double));
+	md->constraints = lp_simplex_malloc((m2 + 1) * sizeof(struct optm_LinearConstraint));
+	md->bounds = lp_simplex_malloc((n2 + 1) * sizeof(struct optm_VariableBound));
+	ps->colmap = (int *)lp_simplex_malloc((n2 + 1) * sizeof(int));
+	ps->reflect = (int *)lp_simplex_malloc((n2 + 1) * sizeof(int));
+	if (!md->objective || !md->coefficients || !md->constraints || !md->bounds || !ps->colmap || !ps->reflect)
+		return lp_simplex_EXIT_FAILURE;
+	lp_simplex_memset(md->coefficients, 0, ((size_t)m2 * n2 + 1) * sizeof(double));
+	lp_simplex_memset(md->bounds, 0, (n2 + 1) * sizeof(struct optm_VariableBound));
+	lp_simplex_memset(md->constraints, 0, (m2 + 1) * sizeof(struct optm_LinearConstraint));
+
+	for (j = 0, k = 0; j < n; j++) {
+		struct optm_VariableBound *bd = md->bounds + k;
+
+		if (!ps->colact[j])
+			continue;
+		ps->colmap[k] = j;
+		ps->reflect[k] = ps->lb[j] == __lp_simplex_NINF__ && ps->ub[j] < __lp_simplex_INF__;
+		md->objective[k] = ps->reflect[k] ? -ps->c[j] : ps->c[j];
+		bd->lb = ps->reflect[k] ? -ps->ub[j] : ps->lb[j];
+		bd->ub = ps->reflect[k] ? __lp_simplex_INF__ : ps->ub[j];
+		if (bd->lb == __lp_simplex_NINF__)
+			bd->b_type = optm_BOUND_T_FR;
+		else
+			bd->b_type = bd->ub < __lp_simplex_INF__ ? optm_BOUND_T_BS : optm_BOUND_T_LO;
+		bd->v_type = optm_VAR_T_REAL;
+		k++;
+	}
+	for (i = 0, m2 = 0; i < ps->m; i++) {
+		struct optm_LinearConstraint *cons = md->constraints + m2;
+
+		if (!ps->rowact[i])
+			continue;
+		cons->coef = md->coefficients + m2 * n2;
+		for (j = 0; j < n2 - nslack; j++) {
+			double aij = ps->a[ps->colmap[j] + i * n];
+
+			cons->coef[j] = ps->reflect[j] ? -aij : aij;
+		}
+		if (ps->rlo[i] == ps->rup[i]) {
+			cons->type = optm_CONS_T_EQ;
+			cons->rhs = ps->rlo[i];
+		} else if (ps->rlo[i] == __lp_simplex_NINF__) {
+			cons->type = optm_CONS_T_LE;
+			cons->rhs = ps->rup[i];
+		} else if (ps->rup[i] == __lp_simplex_INF__) {
+			cons->type = optm_CONS_T_GE;
+			cons->rhs = ps->rlo[i];
+		} else {  /* ranged: row - s = 0, rlo <= s <= rup */
+			cons->type = optm_CONS_T_EQ;
+			cons->rhs = 0.;
+			cons->coef[k] = -1.;
+			ps->colmap[k] = -1;
+			ps->reflect[k] = 0;
+			md->objective[k] = 0.;
+			md->bounds[k].lb = ps->rlo[i];
+			md->bounds[k].ub = ps->rup[i];
+			md->bounds[k].b_type = optm_BOUND_T_BS;
+			md->bounds[k].v_type = optm_VAR_T_REAL;
+			k++;
+		}
+		m2++;
+	}
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+struct lp_simplex_Presolve *lp_simplex_presolve(const double *objective,
+						const struct optm_LinearConstraint *constraints,
+						const struct optm_VariableBound *bounds,
+						const int m, const int n, int *code)
+{
+	struct lp_simplex_Presolve *ps;
+	int state;
+
+	assert(objective != NULL);
+	assert(constraints != NULL);
+	assert(code != NULL);
+
+	ps = presolve_create(objective, constraints, bounds, m, n);
+	if (ps == NULL) {
+		*code = lp_simplex_MemoryAllocError;
+		return NULL;
+	}
+	state = presolve_reduce(ps);
+	if (state == lp_simplex_Success && presolve_emit(ps) == lp_simplex_EXIT_FAILURE)
+		state = lp_simplex_MemoryAllocError;
+	if (state == lp_simplex_Success && ps->model->m == 0 && ps->model->n > 0)
+		state = lp_simplex_Unboundedness;  /* only unbounded empty columns are left */
+	if (state != lp_simplex_Success) {
+		lp_simplex_presolve_free(ps);
+		*code = state;
+		return NULL;
+	}
+	*code = lp_simplex_Success;
+	return ps;
+}
+
+const struct lp_Model *lp_simplex_presolve_model(const struct lp_simplex_Presolve *ps)
+{
+	return ps->model;
+}
+
+/* Value of x_j in [lb, ub] with lo <= a * x_j + s <= hi (closest to 0)
+ */
+static double postsolve_slack(const struct presolve_Record *r, const double s)
+{
+	double lo, hi, v;
+
+	presolve_range(r->a, r->lb, r->ub, &lo, &hi);
+	v = __lp_simplex_MIN__(__lp_simplex_MAX__(0., lo), hi);
+	v = __lp_simplex_MIN__(__lp_simplex_MAX__(v, r->lo - s), r->hi - s);
+	return v / r->a;
+}
+
+void lp_simplex_postsolve(const struct lp_simplex_Presolve *ps, const double *x2, double *x)
+{
+	int j, k;
+
+	lp_simplex_memset(x, 0, ps->n * sizeof(double));
+	for (k = 0; k < ps->model->n; k++) {
+		if (ps->colmap[k] >= 0)
+			x[ps->colmap[k]] = ps->reflect[k] ? -x2[k] : x2[k];
+	}
+	for (k = ps->nrec - 1; k >= 0; k--) {
+		const struct presolve_Record *r = ps->rec + k;
+		double s = 0.;
+
+		for (j = r->beg; j < r->beg + r->len; j++)
+			s += ps->rowval[j] * x[ps->rowidx[j]];
+		switch (r->type) {
+		case __lp_simplex_PRESOLVE_FIX__:
+			x[r->j] = r->value;
+			break;
+		case __lp_simplex_PRESOLVE_SUBST__:
+			x[r->j] = (r->value - s) / r->a;
+			break;
+		case __lp_simplex_PRESOLVE_SLACK__:
+			x[r->j] = postsolve_slack(r, s);
+			break;
+		}
+	}
+}
@@ -0,0 +1,2079 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex_utils.h>
+#include <lp_simplex/lp_simplex.h>
+
+/* Number of eta updates before the basis is refactorized */
+#define __lp_simplex_REV_REFACTOR__		64
+
+/* Controller for pivot leaving rule */
+#define __lp_simplex_REV_PIV_TOL__		1e-9
+
+/* Checker of the reduced costs "LP is optimal" */
+#define __lp_simplex_REV_OPTIMAL__		1e-9
+
+/* Checker of the checking "LP is feasible" */
+#define __lp_simplex_REV_FEASIBLE__		1e-7
+
+/* Eta entries below this magnitude are dropped */
+#define __lp_simplex_REV_DROP__			1e-14
+
+/* Step length regarded as a degenerate pivot */
+#define __lp_simplex_REV_DEGENERATED__		1e-12
+
+/* Number of consecutive degenerate pivots before Bland's rule is used */
+#define __lp_simplex_REV_DEGEN_ITER__		50
+
+/* Bound relaxation of Harris' ratio tests (primal and dual) */
+#define __lp_simplex_REV_HARRIS_TOL__		1e-9
+
+/* Lower limit of dual steepest edge weights */
+#define __lp_simplex_REV_DSE_MIN__		1e-10
+
+/* LP with one logical column per row
+ *
+ *	min  c'x
+ *	s.t. A x + s = b
+ *		lb <= (x, s) <= ub
+ *
+ * Columns are ordered as structural (n), logical (m) and artificial (nart).
+ * The basis is kept as the LU factors of B0 followed by an eta file, that is
+ * B = B0 * E_1 * ... * E_neta, where E_k is the identity but column `etarow[k]`.
+ *
+ * Nonbasic columns sit at one of their bounds (or at zero if free). The
+ * factorized basis is kept between solves so that changes of `rhs` and of
+ * bounds are re-optimized by the dual simplex algorithm. Added rows border
+ * the factors of B0 (their logical columns enter the basis), added columns
+ * leave them as they are.
+ */
+struct lp_simplex_Solver {
+	int m;			/* number of rows */
+	int n;			/* number of structural columns */
+	int nart;		/* number of artificial columns */
+	int ncol;		/* n + m + nart */
+	int solved;		/* the basis is optimal for an earlier solve */
+	int dse_valid;		/* dual steepest edge weights match the basis */
+	int factored;		/* `lu` and the eta file match the basis */
+	int *colbeg;		/* structural columns in CSC (length n + 1) */
+	int *rowidx;
+	double *colval;
+	int *artrow;		/* row of each artificial column */
+	double *artsgn;		/* coefficient of each artificial column */
+	double *rhs;
+	double *obj;		/* objective of structural columns */
+	double *lb;		/* column bounds (length n + 2m) */
+	double *ub;
+	double *cost;		/* cost of the current phase */
+	double *x;		/* value of every column */
+	int *basis;		/* basic column of each row */
+	int *bpos;		/* basis row of each column, -1 if nonbasic */
+	double *lu;		/* LU factors of B0 (column major) */
+	int *ipiv;
+	int neta;
+	int *etarow;
+	int *etabeg;
+	int *etaidx;
+	double *etaval;
+	double *etapiv;
+	double *y;		/* simplex multipliers */
+	double *w;		/* FTRAN of the entering column */
+	double *rho;		/* BTRAN of the leaving row (dual simplex) */
+	double *tau;		/* FTRAN of `rho` (dual steepest edge) */
+	double *dse;		/* dual steepest edge weights of basis rows */
+	double *d;		/* reduced costs (length n + 2m) */
+	double *alpha;		/* pivot row of the dual simplex (length n + 2m) */
+	int *cand;		/* candidates of the dual ratio test (length n + 2m) */
+};
+
+static void *rev_malloc(size_t size)
+{
+	return lp_simplex_malloc(size > 0 ? size : 1);
+}
+
+static void rev_free(struct lp_simplex_Solver *lp)
+{
+	if (lp == NULL)
+		return;
+	if (lp->colbeg)
+		lp_simplex_free(lp->colbeg);
+	if (lp->rowidx)
+		lp_simplex_free(lp->rowidx);
+	if (lp->colval)
+		lp_simplex_free(lp->colval);
+	if (lp->artrow)
+		lp_simplex_free(lp->artrow);
+	if (lp->artsgn)
+		lp_simplex_free(lp->artsgn);
+	if (lp->rhs)
+		lp_simplex_free(lp->rhs);
+	if (lp->obj)
+		lp_simplex_free(lp->obj);
+	if (lp->lb)
+		lp_simplex_free(lp->lb);
+	if (lp->ub)
+		lp_simplex_free(lp->ub);
+	if (lp->cost)
+		lp_simplex_free(lp->cost);
+	if (lp->x)
+		lp_simplex_free(lp->x);
+	if (lp->basis)
+		lp_simplex_free(lp->basis);
+	if (lp->bpos)
+		lp_simplex_free(lp->bpos);
+	if (lp->lu)
+		lp_simplex_free(lp->lu);
+	if (lp->ipiv)
+		lp_simplex_free(lp->ipiv);
+	if (lp->etarow)
+		lp_simplex_free(lp->etarow);
+	if (lp->etabeg)
+		lp_simplex_free(lp->etabeg);
+	if (lp->etaidx)
+		lp_simplex_free(lp->etaidx);
+	if (lp->etaval)
+		lp_simplex_free(lp->etaval);
+	if (lp->etapiv)
+		lp_simplex_free(lp->etapiv);
+	if (lp->y)
+		lp_simplex_free(lp->y);
+	if (lp->w)
+		lp_simplex_free(lp->w);
+	if (lp->rho)
+		lp_simplex_free(lp->rho);
+	if (lp->tau)
+		lp_simplex_free(lp->tau);
+	if (lp->dse)
+		lp_simplex_free(lp->dse);
+	if (lp->d)
+		lp_simplex_free(lp->d);
+	if (lp->alpha)
+		lp_simplex_free(lp->alpha);
+	if (lp->cand)
+		lp_simplex_free(lp->cand);
+	lp_simplex_free(lp);
+}
+
+/* Bounds of a variable as understood by `lp_simplex`
+ */
+static void rev_var_bounds(const struct optm_VariableBound *bd, double *lb, double *ub)
+{
+	*lb = 0.;
+	*ub = __lp_simplex_INF__;
+	if (bd == NULL)
+		return;
+	switch (bd->b_type) {
+	case optm_BOUND_T_FR:
+		*lb = __lp_simplex_NINF__;
+		break;
+	case optm_BOUND_T_UP:
+		*ub = bd->ub;
+		break;
+	case optm_BOUND_T_LO:
+		*lb = bd->lb;
+		break;
+	case optm_BOUND_T_BS:
+		*lb = bd->lb;
+		*ub = bd->ub;
+		break;
+	}
+}
+
+/* To allocate in heap (need to be released by `rev_free`) a revised LP of
+ * m rows, n columns and `nnz` nonzeros
+ */
+static struct lp_simplex_Solver *rev_alloc(const int m, const int n, const int nnz)
+{
+	struct lp_simplex_Solver *lp;
+	int ncolmax = n + 2 * m, etacap = __lp_simplex_REV_REFACTOR__ * m;
+
+	lp = (struct lp_simplex_Solver *)lp_simplex_malloc(sizeof(struct lp_simplex_Solver));
+	if (lp == NULL)
+		return NULL;
+	lp_simplex_memset(lp, 0, sizeof(struct lp_simplex_Solver));
+
+	lp->colbeg = (int *)rev_malloc((n + 1) * sizeof(int));
+	lp->rowidx = (int *)rev_malloc(nnz * sizeof(int));
+	lp->colval = (double *)rev_malloc(nnz * sizeof(double));
+	lp->artrow = (int *)rev_malloc(m * sizeof(int));
+	lp->artsgn = (double *)rev_malloc(m * sizeof(double));
+	lp->rhs = (double *)rev_malloc(m * sizeof(double));
+	lp->obj = (double *)rev_malloc(n * sizeof(double));
+	lp->lb = (double *)rev_malloc(ncolmax * sizeof(double));
+	lp->ub = (double *)rev_malloc(ncolmax * sizeof(double));
+	lp->cost = (double *)rev_malloc(ncolmax * sizeof(double));
+	lp->x = (double *)rev_malloc(ncolmax * sizeof(double));
+	lp->basis = (int *)rev_malloc(m * sizeof(int));
+	lp->bpos = (int *)rev_malloc(ncolmax * sizeof(int));
+	lp->lu = (double *)rev_malloc((size_t)m * m * sizeof(double));
+	lp->ipiv = (int *)rev_malloc(m * sizeof(int));
+	lp->etarow = (int *)rev_malloc(__lp_simplex_REV_REFACTOR__ * sizeof(int));
+	lp->etabeg = (int *)rev_malloc((__lp_simplex_REV_REFACTOR__ + 1) * sizeof(int));
+	lp->etaidx = (int *)rev_malloc(etacap * sizeof(int));
+	lp->etaval = (double *)rev_malloc(etacap * sizeof(double));
+	lp->etapiv = (double *)rev_malloc(__lp_simplex_REV_REFACTOR__ * sizeof(double));
+	lp->y = (double *)rev_malloc(m * sizeof(double));
+	lp->w = (double *)rev_malloc(m * sizeof(double));
+	lp->rho = (double *)rev_malloc(m * sizeof(double));
+	lp->tau = (double *)rev_malloc(m * sizeof(double));
+	lp->dse = (double *)rev_malloc(m * sizeof(double));
+	lp->d = (double *)rev_malloc(ncolmax * sizeof(double));
+	lp->alpha = (double *)rev_malloc(ncolmax * sizeof(double));
+	lp->cand = (int *)rev_malloc(ncolmax * sizeof(int));
+
+	if (!lp->colbeg || !lp->rowidx || !lp->colval || !lp->artrow || !lp->artsgn || !lp->rhs
+	    || !lp->obj || !lp->lb || !lp->ub || !lp->cost || !lp->x || !lp->basis || !lp->bpos
+	    || !lp->lu || !lp->ipiv || !lp->etarow || !lp->etabeg || !lp->etaidx || !lp->etaval
+	    || !lp->etapiv || !lp->y || !lp->w || !lp->rho || !lp->tau || !lp->dse || !lp->d
+	    || !lp->alpha || !lp->cand) {
+		rev_free(lp);
+		return NULL;
+	}
+	lp->m = m;
+	lp->n = n;
+	return lp;
+}
+
+/* Bounds of the logical column of a row of type `type`
+ */
+static void rev_row_bounds(const int type, double *lb, double *ub)
+{
+	switch (type) {
+	case optm_CONS_T_LE:
+		*lb = 0.;
+		*ub = __lp_simplex_INF__;
+		break;
+	case optm_CONS_T_GE:
+		*lb = __lp_simplex_NINF__;
+		*ub = 0.;
+		break;
+	default:
+		*lb = 0.;
+		*ub = 0.;
+		break;
+	}
+}
+
+/* Fill the objective, the bounds and the rows (except coefficients)
+ */
+static void rev_fill(struct lp_simplex_Solver *lp, const double *objective,
+			const struct optm_LinearConstraint *constraints, const struct optm_VariableBound *bounds)
+{
+	int i, j, m = lp->m, n = lp->n;
+
+	for (j = 0; j < n; j++) {
+		rev_var_bounds(bounds ? bounds + j : NULL, lp->lb + j, lp->ub + j);
+		lp->obj[j] = objective[j];
+	}
+	for (i = 0; i < m; i++) {
+		lp->rhs[i] = constraints[i].rhs;
+		rev_row_bounds(constraints[i].type, lp->lb + n + i, lp->ub + n + i);
+	}
+}
+
+/* To create in heap (need to be released by `rev_free`) the revised LP
+ *
+ * Only the nonzeros of `constraints` are copied
+ */
+static struct lp_simplex_Solver *rev_create(const double *objective, const struct optm_LinearConstraint *constraints,
+						const struct optm_VariableBound *bounds, const int m, const int n)
+{
+	struct lp_simplex_Solver *lp;
+	int i, j, nnz = 0;
+
+	for (i = 0; i < m; i++) {
+		for (j = 0; j < n; j++) {
+			if (constraints[i].coef[j] != 0.)
+				nnz++;
+		}
+	}
+	lp = rev_alloc(m, n, nnz);
+	if (lp == NULL)
+		return NULL;
+
+	/* column counts, then positions */
+	lp_simplex_memset(lp->colbeg, 0, (n + 1) * sizeof(int));
+	for (i = 0; i < m; i++) {
+		for (j = 0; j < n; j++) {
+			if (constraints[i].coef[j] != 0.)
+				lp->colbeg[j + 1]++;
+		}
+	}
+	for (j = 0; j < n; j++)
+		lp->colbeg[j + 1] += lp->colbeg[j];
+	lp_simplex_memcpy(lp->bpos, lp->colbeg, n * sizeof(int));
+	for (i = 0; i < m; i++) {
+		for (j = 0; j < n; j++) {
+			double a = constraints[i].coef[j];
+
+			if (a != 0.) {
+				lp->rowidx[lp->bpos[j]] = i;
+				lp->colval[lp->bpos[j]] = a;
+				lp->bpos[j]++;
+			}
+		}
+	}
+	rev_fill(lp, objective, constraints, bounds);
+	return lp;
+}
+
+/* Scatter column `j` into the dense vector `vec` (length m)
+ */
+static void rev_column(const struct lp_simplex_Solver *lp, const int j, double *vec)
+{
+	int k;
+
+	lp_simplex_memset(vec, 0, lp->m * sizeof(double));
+	if (j < lp->n) {
+		for (k = lp->colbeg[j]; k < lp->colbeg[j + 1]; k++)
+			vec[lp->rowidx[k]] = lp->colval[k];
+	} else if (j < lp->n + lp->m)
+		vec[j - lp->n] = 1.;
+	else
+		vec[lp->artrow[j - lp->n - lp->m]] = lp->artsgn[j - lp->n - lp->m];
+}
+
+/* Inner product of column `j` and the dense vector `vec` (length m)
+ */
+static double rev_dot(const struct lp_simplex_Solver *lp, const int j, const double *vec)
+{
+	int k;
+	double s = 0.;
+
+	if (j < lp->n) {
+		for (k = lp->colbeg[j]; k < lp->colbeg[j + 1]; k++)
+			s += lp->colval[k] * vec[lp->rowidx[k]];
+		return s;
+	} else if (j < lp->n + lp->m)
+		return vec[j - lp->n];
+	else
+		return lp->artsgn[j - lp->n - lp->m] * vec[lp->artrow[j - lp->n - lp->m]];
+}
+
+/* Add `mult` times column `j` to the dense vector `vec` (length m)
+ */
+static void rev_add_column(const struct lp_simplex_Solver *lp, const int j, const double mult, double *vec)
+{
+	int k;
+
+	if (j < lp->n) {
+		for (k = lp->colbeg[j]; k < lp->colbeg[j + 1]; k++)
+			vec[lp->rowidx[k]] += lp->colval[k] * mult;
+	} else if (j < lp->n + lp->m)
+		vec[j - lp->n] += mult;
+	else
+		vec[lp->artrow[j - lp->n - lp->m]] += lp->artsgn[j - lp->n - lp->m] * mult;
+}
+
+/* Factorize the current basis from scratch and clear the eta file
+ */
+static int rev_factor(struct lp_simplex_Solver *lp)
+{
+	int i, m = lp->m;
+
+	for (i = 0; i < m; i++)
+		rev_column(lp, lp->basis[i], lp->lu + (size_t)i * m);
+	lp->neta = 0;
+	lp->etabeg[0] = 0;
+	lp->factored = m == 0 || lp_simplex_linalg_dgetrf(m, m, lp->lu, m, lp->ipiv) == 0;
+	return lp->factored ? lp_simplex_EXIT_SUCCESS : lp_simplex_EXIT_FAILURE;
+}
+
+/* Solve B * x = r in place
+ */
+static void rev_ftran(struct lp_simplex_Solver *lp, double *r)
+{
+	int i, k, p;
+	double xp;
+
+	if (lp->m == 0)
+		return;
+	lp_simplex_linalg_dgetrs('N', lp->m, 1, lp->lu, lp->m, lp->ipiv, r, lp->m);
+
+	for (k = 0; k < lp->neta; k++) {
+		p = lp->etarow[k];
+		xp = r[p] / lp->etapiv[k];
+		r[p] = xp;
+		if (xp == 0.)
+			continue;
+		for (i = lp->etabeg[k]; i < lp->etabeg[k + 1]; i++)
+			r[lp->etaidx[i]] -= lp->etaval[i] * xp;
+	}
+}
+
+/* Solve (E_1 * ... * E_neta)' * y = r in place
+ */
+static void rev_btran_eta(const struct lp_simplex_Solver *lp, double *r)
+{
+	int i, k, p;
+	double s;
+
+	for (k = lp->neta - 1; k >= 0; k--) {
+		p = lp->etarow[k];
+		s = r[p];
+		for (i = lp->etabeg[k]; i < lp->etabeg[k + 1]; i++)
+			s -= lp->etaval[i] * r[lp->etaidx[i]];
+		r[p] = s / lp->etapiv[k];
+	}
+}
+
+/* Solve B' * y = r in place
+ */
+static void rev_btran(struct lp_simplex_Solver *lp, double *r)
+{
+	if (lp->m == 0)
+		return;
+	rev_btran_eta(lp, r);
+	lp_simplex_linalg_dgetrs('T', lp->m, 1, lp->lu, lp->m, lp->ipiv, r, lp->m);
+}
+
+/* Append the eta column of a pivot on row `p` with FTRAN-ed column `w`
+ */
+static void rev_push_eta(struct lp_simplex_Solver *lp, const int p, const double *w)
+{
+	int i, nz = lp->etabeg[lp->neta];
+
+	lp->etarow[lp->neta] = p;
+	lp->etapiv[lp->neta] = w[p];
+	for (i = 0; i < lp->m; i++) {
+		if (i == p || __lp_simplex_ABS__(w[i]) <= __lp_simplex_REV_DROP__)
+			continue;
+		lp->etaidx[nz] = i;
+		lp->etaval[nz] = w[i];
+		nz++;
+	}
+	lp->neta++;
+	lp->etabeg[lp->neta] = nz;
+}
+
+/* Recompute basic variables x_B = B^{-1} (b - N * x_N)
+ */
+static void rev_compute_xb(struct lp_simplex_Solver *lp)
+{
+	int i, j;
+	double *r = lp->w;
+
+	lp_simplex_memcpy(r, lp->rhs, lp->m * sizeof(double));
+	for (j = 0; j < lp->ncol; j++) {
+		if (lp->bpos[j] < 0 && lp->x[j] != 0.)
+			rev_add_column(lp, j, -lp->x[j], r);
+	}
+	rev_ftran(lp, r);
+	for (i = 0; i < lp->m; i++)
+		lp->x[lp->basis[i]] = r[i];
+}
+
+/* Refactorize and recompute the basic solution
+ */
+static int rev_refactor(struct lp_simplex_Solver *lp)
+{
+	if (rev_factor(lp) == lp_simplex_EXIT_FAILURE)
+		return lp_simplex_EXIT_FAILURE;
+	rev_compute_xb(lp);
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+/* Compute simplex multipliers y = B^{-T} c_B and the reduced costs of nonbasic columns
+ */
+static void rev_price(struct lp_simplex_Solver *lp)
+{
+	int i, j;
+
+	for (i = 0; i < lp->m; i++)
+		lp->y[i] = lp->cost[lp->basis[i]];
+	rev_btran(lp, lp->y);
+	for (j = 0; j < lp->ncol; j++) {
+		if (lp->bpos[j] >= 0)
+			lp->d[j] = 0.;
+		else
+			lp->d[j] = lp->cost[j] - rev_dot(lp, j, lp->y);
+	}
+}
+
+/* Choose the variable to enter basis (Dantzig, or Bland if `bland`)
+ * Return the index of the column, or -1 if the current basis is optimal.
+ * `dir` is +1 if the entering variable increases and -1 if it decreases.
+ */
+static int rev_enter_rule(const struct lp_simplex_Solver *lp, const int bland, int *dir)
+{
+	int j, q = -1;
+	double dj, best = __lp_simplex_REV_OPTIMAL__;
+
+	for (j = 0; j < lp->ncol; j++) {
+		if (lp->bpos[j] >= 0)
+			continue;
+		dj = lp->d[j];
+
+		if (dj < -__lp_simplex_REV_OPTIMAL__ && lp->x[j] < lp->ub[j]) {
+			if (-dj > best) {
+				best = -dj;
+				q = j;
+				*dir = 1;
+			}
+		} else if (dj > __lp_simplex_REV_OPTIMAL__ && lp->x[j] > lp->lb[j]) {
+			if (dj > best) {
+				best = dj;
+				q = j;
+				*dir = -1;
+			}
+		} else
+			continue;
+		if (bland)
+			return q;
+	}
+	return q;
+}
+
+/* Ratio of row i for entering column moving in `dir`, with the bound relaxed by `tol`
+ * Return `INF` if the basic variable of row i does not block the move
+ */
+static double rev_row_ratio(const struct lp_simplex_Solver *lp, const int i, const int dir, const double tol)
+{
+	int j = lp->basis[i];
+	double t, delta = -dir * lp->w[i];
+
+	if (__lp_simplex_ABS__(lp->w[i]) <= __lp_simplex_REV_PIV_TOL__)
+		return __lp_simplex_INF__;
+	if (delta < 0) {
+		if (lp->lb[j] == __lp_simplex_NINF__)
+			return __lp_simplex_INF__;
+		t = (lp->x[j] - lp->lb[j] + tol) / (-delta);
+	} else {
+		if (lp->ub[j] == __lp_simplex_INF__)
+			return __lp_simplex_INF__;
+		t = (lp->ub[j] - lp->x[j] + tol) / delta;
+	}
+	return __lp_simplex_MAX__(t, 0.);
+}
+
+/* Choose the variable to leave basis for entering column `q` moving in `dir`
+ * (Harris' two-pass ratio test, or the textbook one with Bland's rule)
+ *
+ * Return:
+ *	row index of the leaving variable
+ *	-1 if the entering variable reaches its opposite bound first
+ *	-2 if the step is unbounded
+ */
+static int rev_leave_rule(const struct lp_simplex_Solver *lp, const int q, const int dir,
+				const int bland, double *step)
+{
+	int i, p = -2;
+	double t, tmax = __lp_simplex_INF__, wmax = 0.;
+	double tol = bland ? 0. : __lp_simplex_REV_HARRIS_TOL__;
+
+	for (i = 0; i < lp->m; i++) {  /* pass 1: relaxed bounds */
+		t = rev_row_ratio(lp, i, dir, tol);
+		if (t < tmax)
+			tmax = t;
+	}
+	*step = lp->ub[q] - lp->lb[q];
+	if (*step < __lp_simplex_INF__ && *step <= tmax)
+		return -1;
+	if (tmax == __lp_simplex_INF__)
+		return -2;
+	for (i = 0; i < lp->m; i++) {  /* pass 2: largest pivot within the relaxed step */
+		t = rev_row_ratio(lp, i, dir, 0.);
+		if (t > tmax)
+			continue;
+		if (p < 0 || (bland ? lp->basis[i] < lp->basis[p] : __lp_simplex_ABS__(lp->w[i]) > wmax)) {
+			p = i;
+			wmax = __lp_simplex_ABS__(lp->w[i]);
+			*step = t;
+		}
+	}
+	return p;
+}
+
+/* Move the entering column `q` by `step` in direction `dir` and pivot on row `p`
+ */
+static void rev_update(struct lp_simplex_Solver *lp, const int q, const int p, const int dir, const double step)
+{
+	int i, j;
+
+	if (step > 0.) {
+		for (i = 0; i < lp->m; i++)
+			lp->x[lp->basis[i]] -= dir * step * lp->w[i];
+	}
+	if (p < 0) {  /* bound flip, the basis is unchanged */
+		lp->x[q] = dir > 0 ? lp->ub[q] : lp->lb[q];
+		return;
+	}
+	lp->x[q] += dir * step;
+	j = lp->basis[p];
+	lp->x[j] = -dir * lp->w[p] < 0 ? lp->lb[j] : lp->ub[j];
+	lp->basis[p] = q;
+	lp->bpos[q] = p;
+	lp->bpos[j] = -1;
+	rev_push_eta(lp, p, lp->w);
+}
+
+/* Primal simplex iterations on the current cost vector
+ *
+ * Return:
+ *	0: current BFS is NOT optimal (stop before converged)
+ *	1: current BFS is optimal
+ *	2: LP is unbounded
+ *	4: basis is singular
+ */
+static int rev_primal(struct lp_simplex_Solver *lp, int *epoch, const int niter)
+{
+	int p, q, dir = 1, bland = 0, degen_iter = 0;
+	double step;
+
+	while (*epoch < niter) {
+		(*epoch)++;
+		rev_price(lp);
+		q = rev_enter_rule(lp, bland, &dir);
+		if (q < 0)
+			return 1;
+		rev_column(lp, q, lp->w);
+		rev_ftran(lp, lp->w);
+		p = rev_leave_rule(lp, q, dir, bland, &step);
+		if (p == -2)
+			return 2;
+		rev_update(lp, q, p, dir, step);
+
+		if (step <= __lp_simplex_REV_DEGENERATED__) {
+			degen_iter++;
+			if (degen_iter > __lp_simplex_REV_DEGEN_ITER__)
+				bland = 1;
+		} else {
+			degen_iter = 0;
+			bland = 0;
+		}
+		if (lp->neta >= __lp_simplex_REV_REFACTOR__) {
+			if (rev_refactor(lp) == lp_simplex_EXIT_FAILURE)
+				return 4;
+		}
+	}
+	return 0;
+}
+
+/* Value of a nonbasic column: the finite bound closest to zero, or zero if free
+ */
+static double rev_nonbasic_value(const double lb, const double ub)
+{
+	if (lb > __lp_simplex_NINF__ && (ub == __lp_simplex_INF__ || __lp_simplex_ABS__(lb) <= __lp_simplex_ABS__(ub)))
+		return lb;
+	if (ub < __lp_simplex_INF__)
+		return ub;
+	return 0.;
+}
+
+/* Form the starting basis of logical columns and add an artificial column
+ * for every row whose logical variable would violate its bounds
+ */
+static void rev_start_basis(struct lp_simplex_Solver *lp)
+{
+	int i, j, k, m = lp->m, n = lp->n;
+	double v, *r = lp->w;
+
+	lp->nart = 0;
+	lp->solved = 0;
+	lp->dse_valid = 0;
+	lp_simplex_memcpy(r, lp->rhs, m * sizeof(double));
+	for (j = 0; j < n + m; j++) {
+		lp->bpos[j] = -1;
+		lp->x[j] = rev_nonbasic_value(lp->lb[j], lp->ub[j]);
+		if (j >= n || lp->x[j] == 0.)
+			continue;
+		for (k = lp->colbeg[j]; k < lp->colbeg[j + 1]; k++)
+			r[lp->rowidx[k]] -= lp->colval[k] * lp->x[j];
+	}
+	for (i = 0; i < m; i++) {
+		v = r[i];
+		if (lp->lb[n + i] <= v && v <= lp->ub[n + i]) {
+			lp->basis[i] = n + i;
+			lp->bpos[n + i] = i;
+			lp->x[n + i] = v;
+			continue;
+		}
+		v -= lp->x[n + i];
+		k = n + m + lp->nart;
+		lp->artrow[lp->nart] = i;
+		lp->artsgn[lp->nart] = v >= 0 ? 1. : -1.;
+		lp->lb[k] = 0.;
+		lp->ub[k] = __lp_simplex_INF__;
+		lp->x[k] = __lp_simplex_ABS__(v);
+		lp->basis[i] = k;
+		lp->bpos[k] = i;
+		lp->nart++;
+	}
+	lp->ncol = n + m + lp->nart;
+}
+
+/* Set the cost vector of phase 2
+ */
+static void rev_phase_2_cost(struct lp_simplex_Solver *lp)
+{
+	int j;
+
+	for (j = 0; j < lp->ncol; j++)
+		lp->cost[j] = j < lp->n ? lp->obj[j] : 0.;
+}
+
+/* Choose the variable to leave basis in the dual simplex algorithm
+ * (dual steepest edge: largest infeasibility^2 / ||row of B^{-1}||^2)
+ *
+ * Return the row index, or -1 if the basis is primal feasible.
+ * `delta` is the infeasibility: negative below the lower bound.
+ */
+static int rev_dual_leave_rule(const struct lp_simplex_Solver *lp, double *delta)
+{
+	int i, j, r = -1;
+	double infeas, score, best = 0.;
+
+	for (i = 0; i < lp->m; i++) {
+		j = lp->basis[i];
+		if (lp->x[j] < lp->lb[j] - __lp_simplex_REV_FEASIBLE__)
+			infeas = lp->x[j] - lp->lb[j];
+		else if (lp->x[j] > lp->ub[j] + __lp_simplex_REV_FEASIBLE__)
+			infeas = lp->x[j] - lp->ub[j];
+		else
+			continue;
+		score = infeas * infeas / lp->dse[i];
+		if (score > best) {
+			best = score;
+			r = i;
+			*delta = infeas;
+		}
+	}
+	return r;
+}
+
+/* Dual ratio of nonbasic column j for the leaving infeasibility `delta`,
+ * with the reduced cost relaxed by `tol`
+ * Return `INF` if column j does not block the dual step
+ */
+static double rev_dual_ratio(const struct lp_simplex_Solver *lp, const int j, const double delta,
+				const double tol)
+{
+	double a = delta > 0 ? lp->alpha[j] : -lp->alpha[j];
+
+	if (a > __lp_simplex_REV_PIV_TOL__ && lp->x[j] < lp->ub[j])
+		return __lp_simplex_MAX__(lp->d[j] + tol, 0.) / a;
+	if (a < -__lp_simplex_REV_PIV_TOL__ && lp->x[j] > lp->lb[j])
+		return __lp_simplex_MAX__(-lp->d[j] + tol, 0.) / (-a);
+	return __lp_simplex_INF__;
+}
+
+/* Dual ratio test with bound flipping: choosing the variable to enter basis
+ *
+ * Breakpoints are passed in increasing order (each chosen by Harris' two
+ * passes among the remaining ones) while the leaving infeasibility stays
+ * positive: a boxed column passed this way flips to its opposite bound
+ * instead of entering, so one iteration may take a long dual step.
+ *
+ * Return the index of the column, or -1 if the LP is primal infeasible.
+ * The columns to flip are `cand[0], ..., cand[*nflip - 1]`.
+ */
+static int rev_dual_enter_rule(struct lp_simplex_Solver *lp, const double delta, int *nflip)
+{
+	int j, k, kq, ncand = 0;
+	double t, tmax, amax, slope = __lp_simplex_ABS__(delta);
+
+	for (j = 0; j < lp->ncol; j++) {
+		if (lp->bpos[j] >= 0 || lp->lb[j] == lp->ub[j])
+			continue;
+		if (rev_dual_ratio(lp, j, delta, __lp_simplex_REV_HARRIS_TOL__) < __lp_simplex_INF__)
+			lp->cand[ncand++] = j;
+	}
+	*nflip = 0;
+	while (*nflip < ncand) {
+		tmax = __lp_simplex_INF__;
+		for (k = *nflip; k < ncand; k++) {  /* pass 1: relaxed reduced costs */
+			t = rev_dual_ratio(lp, lp->cand[k], delta, __lp_simplex_REV_HARRIS_TOL__);
+			if (t < tmax)
+				tmax = t;
+		}
+		kq = -1;
+		amax = 0.;
+		for (k = *nflip; k < ncand; k++) {  /* pass 2: largest pivot within the relaxed step */
+			j = lp->cand[k];
+			if (rev_dual_ratio(lp, j, delta, 0.) <= tmax && __lp_simplex_ABS__(lp->alpha[j]) > amax) {
+				amax = __lp_simplex_ABS__(lp->alpha[j]);
+				kq = k;
+			}
+		}
+		j = lp->cand[kq];
+		slope -= amax * (lp->ub[j] - lp->lb[j]);
+		if (slope <= 0.)
+			return j;
+		lp->cand[kq] = lp->cand[*nflip];  /* boxed column passed: flip it */
+		lp->cand[(*nflip)++] = j;
+	}
+	return -1;
+}
+
+/* Flip columns `cand[0], ..., cand[nflip - 1]` to their opposite bounds and
+ * update the basic variables (the basis is unchanged)
+ */
+static void rev_flip_bounds(struct lp_simplex_Solver *lp, const int nflip)
+{
+	int i, j, k;
+	double xj, *r = lp->tau;
+
+	lp_simplex_memset(r, 0, lp->m * sizeof(double));
+	for (k = 0; k < nflip; k++) {
+		j = lp->cand[k];
+		xj = lp->x[j];
+		lp->x[j] = xj == lp->lb[j] ? lp->ub[j] : lp->lb[j];
+		rev_add_column(lp, j, lp->x[j] - xj, r);
+	}
+	rev_ftran(lp, r);
+	for (i = 0; i < lp->m; i++)
+		lp->x[lp->basis[i]] -= r[i];
+}
+
+/* One iteration of the dual simplex algorithm: row `p`, whose basic variable
+ * violates its bound by `delta` (negative below the lower bound), leaves
+ *
+ * Return:
+ *	0: pivot done
+ *	3: LP is infeasible
+ *	4: basis is singular
+ */
+static int rev_dual_pivot(struct lp_simplex_Solver *lp, const int p, double delta)
+{
+	int i, j, q, nflip;
+	double step, alpha_pq, ratio, beta_p, g;
+
+	rev_price(lp);
+	lp_simplex_memset(lp->rho, 0, lp->m * sizeof(double));
+	lp->rho[p] = 1.;
+	rev_btran(lp, lp->rho);
+	for (j = 0; j < lp->ncol; j++)
+		lp->alpha[j] = lp->bpos[j] >= 0 ? 0. : rev_dot(lp, j, lp->rho);
+	q = rev_dual_enter_rule(lp, delta, &nflip);
+	if (q < 0)
+		return 3;
+	if (nflip > 0) {  /* the leaving variable stays infeasible on the same side */
+		rev_flip_bounds(lp, nflip);
+		j = lp->basis[p];
+		delta = delta < 0 ? lp->x[j] - lp->lb[j] : lp->x[j] - lp->ub[j];
+	}
+	rev_column(lp, q, lp->w);
+	rev_ftran(lp, lp->w);
+	alpha_pq = lp->w[p];
+	if (__lp_simplex_ABS__(alpha_pq) <= __lp_simplex_REV_PIV_TOL__)
+		return 4;
+
+	/* dual steepest edge weights */
+	lp_simplex_memcpy(lp->tau, lp->rho, lp->m * sizeof(double));
+	rev_ftran(lp, lp->tau);
+	beta_p = lp->dse[p];
+	for (i = 0; i < lp->m; i++) {
+		if (i == p)
+			continue;
+		ratio = lp->w[i] / alpha_pq;
+		g = lp->dse[i] - 2 * ratio * lp->tau[i] + ratio * ratio * beta_p;
+		lp->dse[i] = __lp_simplex_MAX__(g, __lp_simplex_REV_DSE_MIN__);
+	}
+	lp->dse[p] = __lp_simplex_MAX__(beta_p / (alpha_pq * alpha_pq), __lp_simplex_REV_DSE_MIN__);
+
+	/* primal step: the leaving variable moves onto its violated bound */
+	step = delta / alpha_pq;
+	for (i = 0; i < lp->m; i++)
+		lp->x[lp->basis[i]] -= step * lp->w[i];
+	lp->x[q] += step;
+	j = lp->basis[p];
+	lp->x[j] = delta < 0 ? lp->lb[j] : lp->ub[j];
+	lp->basis[p] = q;
+	lp->bpos[q] = p;
+	lp->bpos[j] = -1;
+	rev_push_eta(lp, p, lp->w);
+	return 0;
+}
+
+/* Start the dual steepest edge weights from 1 unless they match the basis
+ */
+static void rev_dse_init(struct lp_simplex_Solver *lp)
+{
+	int i;
+
+	if (lp->dse_valid)
+		return;
+	for (i = 0; i < lp->m; i++)
+		lp->dse[i] = 1.;
+	lp->dse_valid = 1;
+}
+
+/* Dual simplex iterations from a dual feasible basis
+ *
+ * Return:
+ *	0: current basis is NOT optimal (stop before converged)
+ *	1: current basis is optimal
+ *	3: LP is infeasible
+ *	4: basis is singular
+ */
+static int rev_dual(struct lp_simplex_Solver *lp, int *epoch, const int niter)
+{
+	int p, state;
+	double delta;
+
+	rev_dse_init(lp);
+	while (*epoch < niter) {
+		(*epoch)++;
+		p = rev_dual_leave_rule(lp, &delta);
+		if (p < 0)
+			return 1;
+		state = rev_dual_pivot(lp, p, delta);
+		if (state != 0)
+			return state;
+		if (lp->neta >= __lp_simplex_REV_REFACTOR__) {
+			if (rev_refactor(lp) == lp_simplex_EXIT_FAILURE)
+				return 4;
+		}
+	}
+	return 0;
+}
+
+/* Check the reduced costs of the current basis
+ * Return 1 if it is dual feasible
+ */
+static int rev_dual_feasible(const struct lp_simplex_Solver *lp)
+{
+	int j;
+
+	for (j = 0; j < lp->ncol; j++) {
+		if (lp->bpos[j] >= 0)
+			continue;
+		if (lp->d[j] < -__lp_simplex_REV_OPTIMAL__ && lp->x[j] < lp->ub[j])
+			return 0;
+		if (lp->d[j] > __lp_simplex_REV_OPTIMAL__ && lp->x[j] > lp->lb[j])
+			return 0;
+	}
+	return 1;
+}
+
+/* Check the basic variables of the current basis
+ * Return 1 if it is primal feasible
+ */
+static int rev_primal_feasible(const struct lp_simplex_Solver *lp)
+{
+	int i, j;
+
+	for (i = 0; i < lp->m; i++) {
+		j = lp->basis[i];
+		if (lp->x[j] < lp->lb[j] - __lp_simplex_REV_FEASIBLE__
+		    || lp->x[j] > lp->ub[j] + __lp_simplex_REV_FEASIBLE__)
+			return 0;
+	}
+	return 1;
+}
+
+static int rev_code(const int state, int *code)
+{
+	switch (state) {
+	case 0:
+		*code = lp_simplex_ExceedIterLimit;
+		break;
+	case 2:
+		*code = lp_simplex_Unboundedness;
+		break;
+	case 3:
+		*code = lp_simplex_Infeasibility;
+		break;
+	case 4:
+		*code = lp_simplex_Singularity;
+		break;
+	default:
+		*code = lp_simplex_PrecisionError;
+		break;
+	}
+	return lp_simplex_EXIT_FAILURE;
+}
+
+/* Two-phase primal simplex from the slack/artificial basis
+ */
+static int rev_solve_cold(struct lp_simplex_Solver *lp, int *epoch, const int niter, int *code)
+{
+	int j, k, state;
+	double infeas = 0.;
+
+	rev_start_basis(lp);
+	if (rev_factor(lp) == lp_simplex_EXIT_FAILURE)
+		return rev_code(4, code);
+
+	/* Phase 1: minimize the sum of artificial variables */
+	if (lp->nart > 0) {
+		for (j = 0; j < lp->ncol; j++)
+			lp->cost[j] = j < lp->n + lp->m ? 0. : 1.;
+		state = rev_primal(lp, epoch, niter);
+		if (state != 1)
+			return rev_code(state == 2 ? 9 : state, code);
+		for (k = lp->n + lp->m; k < lp->ncol; k++) {
+			infeas += lp->x[k];
+			lp->ub[k] = 0.;  /* artificial variables are fixed from now on */
+		}
+		if (infeas > __lp_simplex_REV_FEASIBLE__)
+			return rev_code(3, code);
+		for (k = lp->n + lp->m; k < lp->ncol; k++)
+			lp->x[k] = 0.;
+		if (rev_refactor(lp) == lp_simplex_EXIT_FAILURE)
+			return rev_code(4, code);
+	}
+
+	/* Phase 2: minimize the original objective */
+	rev_phase_2_cost(lp);
+	state = rev_primal(lp, epoch, niter);
+	if (state != 1)
+		return rev_code(state, code);
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+/* Re-optimize from the basis of the previous solve
+ *
+ * Dual simplex if the basis is still dual feasible (changes of `rhs` or
+ * bounds), primal simplex if it is still primal feasible, otherwise cold.
+ */
+static int rev_solve_warm(struct lp_simplex_Solver *lp, int *epoch, const int niter, int *code)
+{
+	int state;
+
+	if (lp->factored)
+		rev_compute_xb(lp);
+	else if (rev_refactor(lp) == lp_simplex_EXIT_FAILURE)
+		return rev_solve_cold(lp, epoch, niter, code);
+	rev_phase_2_cost(lp);
+	rev_price(lp);
+
+	if (rev_dual_feasible(lp)) {
+		state = rev_dual(lp, epoch, niter);
+		if (state == 4)
+			return rev_solve_cold(lp, epoch, niter, code);
+		if (state != 1)
+			return rev_code(state, code);
+		if (rev_refactor(lp) == lp_simplex_EXIT_FAILURE)
+			return rev_code(4, code);
+	} else if (!rev_primal_feasible(lp))
+		return rev_solve_cold(lp, epoch, niter, code);
+	lp->dse_valid = 0;
+	state = rev_primal(lp, epoch, niter);
+	if (state != 1)
+		return rev_code(state, code);
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+struct lp_simplex_Solver *lp_simplex_solver_create(const double *objective,
+						const struct optm_LinearConstraint *constraints,
+						const struct optm_VariableBound *bounds,
+						const int m, const int n)
+{
+	assert(objective != NULL);
+	assert(constraints != NULL);
+
+	return rev_create(objective, constraints, bounds, m, n);
+}
+
+struct lp_simplex_Solver *lp_simplex_solver_create_sparse(struct lp_SparseModel *model)
+{
+	struct lp_simplex_Solver *lp;
+	int n;
+
+	assert(model != NULL);
+
+	if (lp_simplex_sparse_compress(model) == lp_simplex_EXIT_FAILURE)
+		return NULL;
+	n = model->n;
+	lp = rev_alloc(model->m, n, model->nz);
+	if (lp == NULL)
+		return NULL;
+	lp_simplex_memcpy(lp->colbeg, model->colbeg, (n + 1) * sizeof(int));
+	lp_simplex_memcpy(lp->rowidx, model->rowidx, model->nz * sizeof(int));
+	lp_simplex_memcpy(lp->colval, model->colval, model->nz * sizeof(double));
+	rev_fill(lp, model->objective, model->constraints, model->bounds);
+	return lp;
+}
+
+void lp_simplex_solver_free(struct lp_simplex_Solver *solver)
+{
+	rev_free(solver);
+}
+
+void lp_simplex_solver_set_rhs(struct lp_simplex_Solver *solver, const int i, const double rhs)
+{
+	assert(solver != NULL);
+	assert(0 <= i && i < solver->m);
+
+	solver->rhs[i] = rhs;
+}
+
+void lp_simplex_solver_set_objective(struct lp_simplex_Solver *solver, const int j, const double c)
+{
+	assert(solver != NULL);
+	assert(0 <= j && j < solver->n);
+
+	solver->obj[j] = c;
+}
+
+void lp_simplex_solver_set_bounds(struct lp_simplex_Solver *solver, const int j, const double lb, const double ub)
+{
+	double xj;
+
+	assert(solver != NULL);
+	assert(0 <= j && j < solver->n);
+
+	if (solver->bpos[j] < 0) {  /* a nonbasic column stays at the same side */
+		xj = solver->x[j];
+		if (xj == solver->ub[j] && ub < __lp_simplex_INF__)
+			solver->x[j] = ub;
+		else if (xj == solver->lb[j] && lb > __lp_simplex_NINF__)
+			solver->x[j] = lb;
+		else
+			solver->x[j] = rev_nonbasic_value(lb, ub);
+	}
+	solver->lb[j] = lb;
+	solver->ub[j] = ub;
+}
+
+int lp_simplex_solver_get_basis(const struct lp_simplex_Solver *solver, int *cstat, int *rstat)
+{
+	int i, j, n;
+
+	assert(solver != NULL);
+	assert(cstat != NULL);
+	assert(rstat != NULL);
+
+	if (!solver->solved)
+		return lp_simplex_EXIT_FAILURE;
+	n = solver->n;
+	for (j = 0; j < n; j++) {
+		if (solver->bpos[j] >= 0)
+			cstat[j] = lp_simplex_BASIS_BASIC;
+		else if (solver->x[j] == solver->ub[j] && solver->lb[j] != solver->ub[j])
+			cstat[j] = lp_simplex_BASIS_UPPER;
+		else
+			cstat[j] = lp_simplex_BASIS_LOWER;
+	}
+	for (i = 0; i < solver->m; i++) {  /* the row activity is `rhs` - logical */
+		j = n + i;
+		if (solver->bpos[j] >= 0)
+			rstat[i] = lp_simplex_BASIS_BASIC;
+		else if (solver->x[j] == solver->lb[j] && solver->lb[j] != solver->ub[j])
+			rstat[i] = lp_simplex_BASIS_UPPER;
+		else
+			rstat[i] = lp_simplex_BASIS_LOWER;
+	}
+	for (i = 0; i < solver->m; i++) {
+		j = solver->basis[i];
+		if (j >= n + solver->m)  /* a (zero) artificial column stands for its row */
+			rstat[solver->artrow[j - n - solver->m]] = lp_simplex_BASIS_BASIC;
+	}
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+int lp_simplex_solver_set_basis(struct lp_simplex_Solver *solver, const int *cstat, const int *rstat)
+{
+	int j, k, nbasic = 0, m, n;
+	double lb, ub;
+
+	assert(solver != NULL);
+	assert(cstat != NULL);
+	assert(rstat != NULL);
+
+	m = solver->m;
+	n = solver->n;
+	for (j = 0; j < n + m; j++)
+		nbasic += (j < n ? cstat[j] : rstat[j - n]) == lp_simplex_BASIS_BASIC;
+	if (nbasic != m)
+		return lp_simplex_EXIT_FAILURE;
+	solver->nart = 0;
+	solver->ncol = n + m;
+	for (j = 0, k = 0; j < n + m; j++) {
+		int stat = j < n ? cstat[j] : rstat[j - n];
+
+		solver->bpos[j] = -1;
+		if (stat == lp_simplex_BASIS_BASIC) {
+			solver->basis[k] = j;
+			solver->bpos[j] = k++;
+			continue;
+		}
+		lb = solver->lb[j];
+		ub = solver->ub[j];
+		if (j >= n)  /* the logical is at the opposite side of its row */
+			stat = stat == lp_simplex_BASIS_UPPER ? lp_simplex_BASIS_LOWER : lp_simplex_BASIS_UPPER;
+		if (stat == lp_simplex_BASIS_UPPER && ub < __lp_simplex_INF__)
+			solver->x[j] = ub;
+		else if (stat == lp_simplex_BASIS_LOWER && lb > __lp_simplex_NINF__)
+			solver->x[j] = lb;
+		else
+			solver->x[j] = rev_nonbasic_value(lb, ub);
+	}
+	solver->solved = 1;  /* the next solve starts from this basis */
+	solver->dse_valid = 0;
+	solver->factored = 0;
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+/* To allocate in heap (need to be released by `rev_free`) a copy of `lp` with
+ * m2 rows and n2 structural columns (room for `nnz2` nonzeros)
+ *
+ * Row i moves to `rmap[i]` and column k to `cmap[k]` (dropped if -1), keeping
+ * their order; rows `cons[0]`, ..., `cons[nrow - 1]` follow at m2 - nrow
+ * (coefficients of the old structural columns). The basic columns kept stay
+ * in the basis in the same order; the factors are not copied.
+ */
+static struct lp_simplex_Solver *rev_remap(const struct lp_simplex_Solver *lp, const int *rmap, const int m2,
+						const int *cmap, const int n2, const int nnz2,
+						const struct optm_LinearConstraint *cons, const int nrow)
+{
+	struct lp_simplex_Solver *nw;
+	int i, j, k, c, p = 0, nz = 0, ncolumn = 0;
+
+	nw = rev_alloc(m2, n2, nnz2);
+	if (nw == NULL)
+		return NULL;
+	for (j = 0; j < lp->n; j++) {
+		if ((c = cmap[j]) < 0)
+			continue;
+		nw->colbeg[c] = nz;
+		for (k = lp->colbeg[j]; k < lp->colbeg[j + 1]; k++) {
+			if (rmap[lp->rowidx[k]] < 0)
+				continue;
+			nw->rowidx[nz] = rmap[lp->rowidx[k]];
+			nw->colval[nz++] = lp->colval[k];
+		}
+		for (i = 0; i < nrow; i++) {
+			if (cons[i].coef[j] == 0.)
+				continue;
+			nw->rowidx[nz] = m2 - nrow + i;
+			nw->colval[nz++] = cons[i].coef[j];
+		}
+		nw->obj[c] = lp->obj[j];
+		ncolumn = c + 1;
+	}
+	for (c = ncolumn; c <= n2; c++)  /* columns appended by the caller */
+		nw->colbeg[c] = nz;
+	for (i = 0; i < lp->m; i++) {
+		if (rmap[i] >= 0)
+			nw->rhs[rmap[i]] = lp->rhs[i];
+	}
+	for (k = 0; k < lp->nart; k++) {
+		if (cmap[lp->n + lp->m + k] < 0)
+			continue;
+		nw->artrow[nw->nart] = rmap[lp->artrow[k]];
+		nw->artsgn[nw->nart++] = lp->artsgn[k];
+	}
+	nw->ncol = n2 + m2 + nw->nart;
+	for (k = 0; k < n2 + 2 * m2; k++)
+		nw->bpos[k] = -1;
+	for (k = 0; k < lp->ncol; k++) {
+		if ((c = cmap[k]) < 0)
+			continue;
+		nw->lb[c] = lp->lb[k];
+		nw->ub[c] = lp->ub[k];
+		nw->x[c] = lp->x[k];
+	}
+	for (i = 0; lp->solved && i < lp->m; i++) {
+		if ((c = cmap[lp->basis[i]]) < 0)
+			continue;
+		nw->basis[p] = c;
+		nw->bpos[c] = p;
+		nw->dse[p++] = lp->dse[i];
+	}
+	nw->solved = lp->solved;
+	nw->dse_valid = lp->dse_valid;
+	return nw;
+}
+
+/* Move the content of `nw` (released) into `lp`
+ */
+static void rev_swap(struct lp_simplex_Solver *lp, struct lp_simplex_Solver *nw)
+{
+	struct lp_simplex_Solver tmp = *lp;
+
+	*lp = *nw;
+	*nw = tmp;
+	rev_free(nw);
+}
+
+/* Copy the factors of `lp` into `nw` having as many or more rows, whose
+ * basis is that of `lp` followed by logical columns (identity)
+ */
+static void rev_copy_factor(struct lp_simplex_Solver *nw, const struct lp_simplex_Solver *lp)
+{
+	int i, m = lp->m, m2 = nw->m, nz = lp->etabeg[lp->neta];
+
+	lp_simplex_memset(nw->lu, 0, (size_t)m2 * m2 * sizeof(double));
+	for (i = 0; i < m; i++) {
+		lp_simplex_memcpy(nw->lu + (size_t)i * m2, lp->lu + (size_t)i * m, m * sizeof(double));
+		nw->ipiv[i] = lp->ipiv[i];
+	}
+	for (i = m; i < m2; i++) {
+		nw->lu[(size_t)i * m2 + i] = 1.;
+		nw->ipiv[i] = i + 1;
+	}
+	nw->neta = lp->neta;
+	lp_simplex_memcpy(nw->etarow, lp->etarow, lp->neta * sizeof(int));
+	lp_simplex_memcpy(nw->etapiv, lp->etapiv, lp->neta * sizeof(double));
+	lp_simplex_memcpy(nw->etabeg, lp->etabeg, (lp->neta + 1) * sizeof(int));
+	lp_simplex_memcpy(nw->etaidx, lp->etaidx, nz * sizeof(int));
+	lp_simplex_memcpy(nw->etaval, lp->etaval, nz * sizeof(double));
+	nw->factored = 1;
+}
+
+/* Replace the basic column of row `p` by column `q` (FTRAN-ed in `w`); the
+ * leaving column goes to its bound closest to its value
+ */
+static int rev_swap_basic(struct lp_simplex_Solver *lp, const int p, const int q, const double *w)
+{
+	int j = lp->basis[p];
+	double lb = lp->lb[j], ub = lp->ub[j], xj = lp->x[j];
+
+	if (lb > __lp_simplex_NINF__ && (ub == __lp_simplex_INF__ || xj - lb <= ub - xj))
+		lp->x[j] = lb;
+	else
+		lp->x[j] = rev_nonbasic_value(lb, ub);
+	lp->basis[p] = q;
+	lp->bpos[q] = p;
+	lp->bpos[j] = -1;
+	lp->dse_valid = 0;
+	rev_push_eta(lp, p, w);
+	if (lp->neta >= __lp_simplex_REV_REFACTOR__)
+		return rev_factor(lp);
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+int lp_simplex_solver_add_rows(struct lp_simplex_Solver *solver, const int nrow,
+				const struct optm_LinearConstraint *constraints)
+{
+	struct lp_simplex_Solver *nw;
+	int i, j, r, k, c, m, n, nnz, *rmap, *cmap;
+	double t, *s, *z;
+
+	assert(solver != NULL);
+	assert(constraints != NULL || nrow == 0);
+
+	m = solver->m;
+	n = solver->n;
+	nnz = solver->colbeg[n];
+	for (r = 0; r < nrow; r++) {
+		for (j = 0; j < n; j++)
+			nnz += constraints[r].coef[j] != 0.;
+	}
+	rmap = (int *)rev_malloc(m * sizeof(int));
+	cmap = (int *)rev_malloc(solver->ncol * sizeof(int));
+	if (rmap == NULL || cmap == NULL) {
+		if (rmap)
+			lp_simplex_free(rmap);
+		if (cmap)
+			lp_simplex_free(cmap);
+		return lp_simplex_EXIT_FAILURE;
+	}
+	for (i = 0; i < m; i++)
+		rmap[i] = i;
+	for (k = 0; k < solver->ncol; k++)
+		cmap[k] = k < n + m ? k : k + nrow;
+	nw = rev_remap(solver, rmap, m + nrow, cmap, n, nnz, constraints, nrow);
+	lp_simplex_free(rmap);
+	lp_simplex_free(cmap);
+	if (nw == NULL)
+		return lp_simplex_EXIT_FAILURE;
+	for (r = 0; r < nrow; r++) {
+		c = n + m + r;
+		nw->rhs[m + r] = constraints[r].rhs;
+		rev_row_bounds(constraints[r].type, nw->lb + c, nw->ub + c);
+		nw->x[c] = 0.;
+		nw->basis[m + r] = c;  /* the new logical columns are basic */
+		nw->bpos[c] = m + r;
+		nw->dse[m + r] = 1.;
+	}
+
+	/* B = B0 * E with the new rows r_B: the factors of B0 get the rows
+	 * s = r_B * E^{-1} and L the rows s * U^{-1} */
+	if (solver->solved && solver->factored) {
+		rev_copy_factor(nw, solver);
+		s = nw->y;
+		z = nw->rho;
+		for (r = 0; r < nrow; r++) {
+			for (i = 0; i < m; i++) {
+				j = solver->basis[i];
+				s[i] = j < n ? constraints[r].coef[j] : 0.;
+			}
+			lp_simplex_memcpy(z, s, m * sizeof(double));
+			rev_btran(solver, z);  /* row m + r of B^{-1} is (-z, e_r) */
+			t = 1.;
+			for (i = 0; i < m; i++)
+				t += z[i] * z[i];
+			nw->dse[m + r] = t;
+			rev_btran_eta(solver, s);
+			for (j = 0; j < m; j++) {
+				t = s[j];
+				for (i = 0; i < j; i++)
+					t -= z[i] * solver->lu[(size_t)j * m + i];
+				z[j] = t / solver->lu[(size_t)j * m + j];
+				nw->lu[(size_t)j * (m + nrow) + m + r] = z[j];
+			}
+		}
+	}
+	rev_swap(solver, nw);
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+int lp_simplex_solver_add_cols(struct lp_simplex_Solver *solver, const int ncol, const double *objective,
+				const double *coef, const struct optm_VariableBound *bounds)
+{
+	struct lp_simplex_Solver *nw;
+	int i, j, k, c, m, n, nnz, *rmap, *cmap;
+	double a;
+
+	assert(solver != NULL);
+	assert((objective != NULL && coef != NULL) || ncol == 0);
+
+	m = solver->m;
+	n = solver->n;
+	nnz = solver->colbeg[n];
+	for (k = 0; k < ncol * m; k++)
+		nnz += coef[k] != 0.;
+	rmap = (int *)rev_malloc(m * sizeof(int));
+	cmap = (int *)rev_malloc(solver->ncol * sizeof(int));
+	if (rmap == NULL || cmap == NULL) {
+		if (rmap)
+			lp_simplex_free(rmap);
+		if (cmap)
+			lp_simplex_free(cmap);
+		return lp_simplex_EXIT_FAILURE;
+	}
+	for (i = 0; i < m; i++)
+		rmap[i] = i;
+	for (k = 0; k < solver->ncol; k++)
+		cmap[k] = k < n ? k : k + ncol;
+	nw = rev_remap(solver, rmap, m, cmap, n + ncol, nnz, NULL, 0);
+	lp_simplex_free(rmap);
+	lp_simplex_free(cmap);
+	if (nw == NULL)
+		return lp_simplex_EXIT_FAILURE;
+	for (j = 0; j < ncol; j++) {  /* the new columns are nonbasic */
+		c = n + j;
+		k = nw->colbeg[c];
+		for (i = 0; i < m; i++) {
+			if ((a = coef[(size_t)j * m + i]) == 0.)
+				continue;
+			nw->rowidx[k] = i;
+			nw->colval[k++] = a;
+		}
+		nw->colbeg[c + 1] = k;
+		nw->obj[c] = objective[j];
+		rev_var_bounds(bounds ? bounds + j : NULL, nw->lb + c, nw->ub + c);
+		nw->x[c] = rev_nonbasic_value(nw->lb[c], nw->ub[c]);
+	}
+	if (solver->solved && solver->factored)
+		rev_copy_factor(nw, solver);
+	rev_swap(solver, nw);
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+int lp_simplex_solver_del_rows(struct lp_simplex_Solver *solver, const int nrow, const int *rows)
+{
+	struct lp_simplex_Solver *nw;
+	int i, p, k, q, m, n, m2 = 0, *rmap, *cmap;
+	double best;
+
+	assert(solver != NULL);
+	assert(rows != NULL || nrow == 0);
+
+	m = solver->m;
+	n = solver->n;
+	rmap = (int *)rev_malloc(m * sizeof(int));
+	cmap = (int *)rev_malloc(solver->ncol * sizeof(int));
+	if (rmap == NULL || cmap == NULL) {
+		if (rmap)
+			lp_simplex_free(rmap);
+		if (cmap)
+			lp_simplex_free(cmap);
+		return lp_simplex_EXIT_FAILURE;
+	}
+	for (i = 0; i < m; i++)
+		rmap[i] = 0;
+	for (k = 0; k < nrow; k++) {
+		assert(0 <= rows[k] && rows[k] < m);
+		rmap[rows[k]] = -1;
+	}
+
+	/* the logical columns of the deleted rows enter the basis, so that
+	 * the remaining basic columns form a basis of the other rows */
+	if (solver->solved && (solver->factored || rev_factor(solver) == lp_simplex_EXIT_SUCCESS)) {
+		for (i = 0; i < m; i++) {
+			if (rmap[i] == 0 || solver->bpos[n + i] >= 0)
+				continue;
+			rev_column(solver, n + i, solver->w);
+			rev_ftran(solver, solver->w);
+			best = 0.;
+			for (p = 0, q = -1; p < m; p++) {
+				k = solver->basis[p];
+				if (n <= k && k < n + m && rmap[k - n] < 0)
+					continue;
+				if (__lp_simplex_ABS__(solver->w[p]) > best) {
+					best = __lp_simplex_ABS__(solver->w[p]);
+					q = p;
+				}
+			}
+			if (q < 0 || rev_swap_basic(solver, q, n + i, solver->w) == lp_simplex_EXIT_FAILURE) {
+				solver->solved = 0;
+				break;
+			}
+		}
+	} else
+		solver->solved = 0;
+	for (i = 0; i < m; i++)
+		rmap[i] = rmap[i] < 0 ? -1 : m2++;
+	for (k = 0; k < solver->ncol; k++) {
+		if (k < n)
+			cmap[k] = k;
+		else if (k < n + m)
+			cmap[k] = rmap[k - n] < 0 ? -1 : n + rmap[k - n];
+		else
+			cmap[k] = rmap[solver->artrow[k - n - m]] < 0 ? -1 : 0;
+	}
+	for (k = n + m, q = n + m2; k < solver->ncol; k++) {
+		if (cmap[k] == 0)
+			cmap[k] = q++;
+	}
+	nw = rev_remap(solver, rmap, m2, cmap, n, solver->colbeg[n], NULL, 0);
+	lp_simplex_free(rmap);
+	lp_simplex_free(cmap);
+	if (nw == NULL)
+		return lp_simplex_EXIT_FAILURE;
+	nw->dse_valid = 0;
+	rev_swap(solver, nw);
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+int lp_simplex_solver_del_cols(struct lp_simplex_Solver *solver, const int ncol, const int *cols)
+{
+	struct lp_simplex_Solver *nw;
+	int j, p, k, q, m, n, n2 = 0, *rmap, *cmap;
+	double a, best;
+
+	assert(solver != NULL);
+	assert(cols != NULL || ncol == 0);
+
+	m = solver->m;
+	n = solver->n;
+	rmap = (int *)rev_malloc(m * sizeof(int));
+	cmap = (int *)rev_malloc(solver->ncol * sizeof(int));
+	if (rmap == NULL || cmap == NULL) {
+		if (rmap)
+			lp_simplex_free(rmap);
+		if (cmap)
+			lp_simplex_free(cmap);
+		return lp_simplex_EXIT_FAILURE;
+	}
+	for (k = 0; k < solver->ncol; k++)
+		cmap[k] = 0;
+	for (k = 0; k < ncol; k++) {
+		assert(0 <= cols[k] && cols[k] < n);
+		cmap[cols[k]] = -1;
+	}
+
+	/* a deleted basic column leaves for the nonbasic column of the
+	 * largest pivot in its row */
+	if (solver->solved && (solver->factored || rev_factor(solver) == lp_simplex_EXIT_SUCCESS)) {
+		for (j = 0; j < n; j++) {
+			if (cmap[j] == 0 || (p = solver->bpos[j]) < 0)
+				continue;
+			lp_simplex_memset(solver->rho, 0, m * sizeof(double));
+			solver->rho[p] = 1.;
+			rev_btran(solver, solver->rho);
+			best = 0.;
+			for (k = 0, q = -1; k < solver->ncol; k++) {
+				if (solver->bpos[k] >= 0 || cmap[k] < 0)
+					continue;
+				a = __lp_simplex_ABS__(rev_dot(solver, k, solver->rho));
+				if (a > best) {
+					best = a;
+					q = k;
+				}
+			}
+			if (q < 0) {
+				solver->solved = 0;
+				break;
+			}
+			rev_column(solver, q, solver->w);
+			rev_ftran(solver, solver->w);
+			if (rev_swap_basic(solver, p, q, solver->w) == lp_simplex_EXIT_FAILURE) {
+				solver->solved = 0;
+				break;
+			}
+		}
+	} else
+		solver->solved = 0;
+	for (k = 0; k < n; k++)
+		cmap[k] = cmap[k] < 0 ? -1 : n2++;
+	for (k = n; k < solver->ncol; k++)
+		cmap[k] = k - n + n2;
+	for (k = 0; k < m; k++)
+		rmap[k] = k;
+	nw = rev_remap(solver, rmap, m, cmap, n2, solver->colbeg[n], NULL, 0);
+	lp_simplex_free(rmap);
+	lp_simplex_free(cmap);
+	if (nw == NULL)
+		return lp_simplex_EXIT_FAILURE;
+	rev_swap(solver, nw);
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+int lp_simplex_solver_set_coef(struct lp_simplex_Solver *solver, const int i, const int j, const double a)
+{
+	int k, nnz;
+	void *tmp;
+
+	assert(solver != NULL);
+	assert(0 <= i && i < solver->m);
+	assert(0 <= j && j < solver->n);
+
+	if (solver->bpos[j] >= 0) {  /* the basis matrix changes */
+		solver->factored = 0;
+		solver->dse_valid = 0;
+	}
+	for (k = solver->colbeg[j]; k < solver->colbeg[j + 1]; k++) {
+		if (solver->rowidx[k] == i) {
+			solver->colval[k] = a;
+			return lp_simplex_EXIT_SUCCESS;
+		}
+	}
+	if (a == 0.)
+		return lp_simplex_EXIT_SUCCESS;
+	nnz = solver->colbeg[solver->n];
+	if ((tmp = lp_simplex_realloc(solver->rowidx, (nnz + 1) * sizeof(int))) == NULL)
+		return lp_simplex_EXIT_FAILURE;
+	solver->rowidx = (int *)tmp;
+	if ((tmp = lp_simplex_realloc(solver->colval, (nnz + 1) * sizeof(double))) == NULL)
+		return lp_simplex_EXIT_FAILURE;
+	solver->colval = (double *)tmp;
+	for (k = nnz; k > solver->colbeg[j + 1]; k--) {
+		solver->rowidx[k] = solver->rowidx[k - 1];
+		solver->colval[k] = solver->colval[k - 1];
+	}
+	solver->rowidx[k] = i;
+	solver->colval[k] = a;
+	for (k = j + 1; k <= solver->n; k++)
+		solver->colbeg[k]++;
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+/* Range [*lo, *hi] of the step t keeping every basic variable within its
+ * bounds, where the basic variables move by t * `w` (FTRAN-ed column)
+ *
+ * Return the row blocking the step up (or -1 if `hi` is `INF`)
+ */
+static int rev_range_primal(const struct lp_simplex_Solver *lp, const double *w, double *lo, double *hi)
+{
+	int i, j, p = -1;
+	double t;
+
+	*lo = __lp_simplex_NINF__;
+	*hi = __lp_simplex_INF__;
+	for (i = 0; i < lp->m; i++) {
+		if (__lp_simplex_ABS__(w[i]) <= __lp_simplex_REV_DROP__)
+			continue;
+		j = lp->basis[i];
+		if (lp->ub[j] < __lp_simplex_INF__) {  /* x_j + t * w_i <= ub_j */
+			t = (lp->ub[j] - lp->x[j]) / w[i];
+			if (w[i] > 0. && t < *hi) {
+				*hi = t;
+				p = i;
+			}
+			if (w[i] < 0. && t > *lo)
+				*lo = t;
+		}
+		if (lp->lb[j] > __lp_simplex_NINF__) {  /* x_j + t * w_i >= lb_j */
+			t = (lp->lb[j] - lp->x[j]) / w[i];
+			if (w[i] > 0. && t > *lo)
+				*lo = t;
+			if (w[i] < 0. && t < *hi) {
+				*hi = t;
+				p = i;
+			}
+		}
+	}
+	return p;
+}
+
+/* Range [*lo, *hi] of the change t of the cost of the basic variable on row
+ * `p` keeping every reduced cost of the right sign, where the reduced cost of
+ * column k moves by -t * alpha_p_k (`rho` = row p of B^{-1})
+ */
+static void rev_range_dual(const struct lp_simplex_Solver *lp, const double *rho, double *lo, double *hi)
+{
+	int k, isfree;
+	double a, t;
+
+	*lo = __lp_simplex_NINF__;
+	*hi = __lp_simplex_INF__;
+	for (k = 0; k < lp->ncol; k++) {
+		if (lp->bpos[k] >= 0 || lp->lb[k] == lp->ub[k])
+			continue;
+		a = rev_dot(lp, k, rho);
+		if (__lp_simplex_ABS__(a) <= __lp_simplex_REV_DROP__)
+			continue;
+		t = lp->d[k] / a;
+		isfree = lp->x[k] != lp->lb[k] && lp->x[k] != lp->ub[k];
+		if (lp->x[k] == lp->lb[k] || isfree) {  /* d_k - t * a >= 0 */
+			if (a > 0. && t < *hi)
+				*hi = t;
+			if (a < 0. && t > *lo)
+				*lo = t;
+		}
+		if (lp->x[k] == lp->ub[k] || isfree) {  /* d_k - t * a <= 0 */
+			if (a > 0. && t > *lo)
+				*lo = t;
+			if (a < 0. && t < *hi)
+				*hi = t;
+		}
+	}
+	if (*lo > 0.)  /* rounding of d_k */
+		*lo = 0.;
+	if (*hi < 0.)
+		*hi = 0.;
+}
+
+int lp_simplex_solver_ranging(struct lp_simplex_Solver *solver, struct lp_simplex_Ranging *rg)
+{
+	int i, j, p, n, m;
+	double lo, hi, c;
+
+	assert(solver != NULL);
+	assert(rg != NULL);
+
+	if (!solver->solved)
+		return lp_simplex_EXIT_FAILURE;
+	n = solver->n;
+	m = solver->m;
+	rev_phase_2_cost(solver);
+	rev_price(solver);
+	for (i = 0; rg->dual && i < m; i++)
+		rg->dual[i] = solver->y[i];
+	for (j = 0; rg->redcost && j < n; j++)
+		rg->redcost[j] = solver->d[j];
+
+	/* objective coefficients */
+	for (j = 0; (rg->objlo || rg->objup) && j < n; j++) {
+		c = solver->obj[j];
+		p = solver->bpos[j];
+		if (p >= 0) {
+			lp_simplex_memset(solver->rho, 0, m * sizeof(double));
+			solver->rho[p] = 1.;
+			rev_btran(solver, solver->rho);
+			rev_range_dual(solver, solver->rho, &lo, &hi);
+		} else if (solver->lb[j] == solver->ub[j]) {  /* fixed: always optimal */
+			lo = __lp_simplex_NINF__;
+			hi = __lp_simplex_INF__;
+		} else {  /* at lower bound: d_j + t >= 0, at upper bound: d_j + t <= 0, free: both */
+			lo = solver->x[j] != solver->ub[j] ? -solver->d[j] : __lp_simplex_NINF__;
+			hi = solver->x[j] != solver->lb[j] ? -solver->d[j] : __lp_simplex_INF__;
+		}
+		if (rg->objlo)
+			rg->objlo[j] = lo == __lp_simplex_NINF__ ? lo : c + lo;
+		if (rg->objup)
+			rg->objup[j] = hi == __lp_simplex_INF__ ? hi : c + hi;
+	}
+
+	/* right hand sides: b_i + t moves x_B by t * B^{-1} e_i */
+	for (i = 0; (rg->rhslo || rg->rhsup) && i < m; i++) {
+		lp_simplex_memset(solver->w, 0, m * sizeof(double));
+		solver->w[i] = 1.;
+		rev_ftran(solver, solver->w);
+		rev_range_primal(solver, solver->w, &lo, &hi);
+		if (rg->rhslo)
+			rg->rhslo[i] = lo == __lp_simplex_NINF__ ? lo : solver->rhs[i] + lo;
+		if (rg->rhsup)
+			rg->rhsup[i] = hi == __lp_simplex_INF__ ? hi : solver->rhs[i] + hi;
+	}
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+int lp_simplex_solver_solve(struct lp_simplex_Solver *solver, const int niter,
+				double *x, double *value, int *code)
+{
+	int j, epoch = 0, state;
+
+	assert(solver != NULL);
+	assert(x != NULL);
+	assert(value != NULL);
+	assert(code != NULL);
+
+	for (j = 0; j < solver->n; j++) {
+		if (solver->lb[j] > solver->ub[j]) {  /* crossed bounds */
+			solver->solved = 0;
+			return rev_code(3, code);
+		}
+	}
+	if (solver->solved)
+		state = rev_solve_warm(solver, &epoch, niter, code);
+	else
+		state = rev_solve_cold(solver, &epoch, niter, code);
+	solver->solved = 0;
+	if (state == lp_simplex_EXIT_FAILURE)
+		return lp_simplex_EXIT_FAILURE;
+	if (rev_refactor(solver) == lp_simplex_EXIT_FAILURE)
+		return rev_code(4, code);
+	*value = 0.;
+	for (j = 0; j < solver->n; j++) {
+		x[j] = solver->x[j];
+		*value += solver->obj[j] * x[j];
+	}
+	solver->solved = 1;
+	*code = lp_simplex_Success;
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+/* Parametric objective c + t * e from the current basis, whose reduced costs
+ * move by t * `de` (reduced costs of e)
+ *
+ * Return the nonbasic column whose reduced cost changes sign first, at the
+ * step `*t`, and the direction `*dir` in which it enters (or -1 if none)
+ */
+static int rev_param_obj_step(const struct lp_simplex_Solver *lp, const double *de, double *t, int *dir)
+{
+	int k, q = -1, atlb, atub;
+	double r;
+
+	*t = __lp_simplex_INF__;
+	for (k = 0; k < lp->ncol; k++) {
+		if (lp->bpos[k] >= 0 || lp->lb[k] == lp->ub[k] || __lp_simplex_ABS__(de[k]) <= __lp_simplex_REV_DROP__)
+			continue;
+		r = __lp_simplex_MAX__(-lp->d[k] / de[k], 0.);
+		atlb = lp->x[k] == lp->lb[k];
+		atub = lp->x[k] == lp->ub[k];
+		if (r >= *t)
+			continue;
+		if ((atlb || !atub) && de[k] < 0.) {  /* d_k + t * de_k >= 0 */
+			*t = r;
+			*dir = 1;
+			q = k;
+		} else if ((atub || !atlb) && de[k] > 0.) {  /* d_k + t * de_k <= 0 */
+			*t = r;
+			*dir = -1;
+			q = k;
+		}
+	}
+	return q;
+}
+
+/* Write breakpoint `lam` of the current basis at position `*nbp` (or over the
+ * last one if it has the same `lam`)
+ *
+ * Return `EXIT_FAILURE` if `maxbp` breakpoints are already written
+ */
+static int rev_param_record(struct lp_simplex_Solver *lp, const double lam, const int maxbp, int *nbp,
+				double *lambda, double *value, int *cstat, int *rstat)
+{
+	int j, k = *nbp;
+
+	if (k > 0 && lambda[k - 1] == lam)
+		k--;
+	else if (k == maxbp)
+		return lp_simplex_EXIT_FAILURE;
+	else
+		(*nbp)++;
+	lambda[k] = lam;
+	value[k] = 0.;
+	for (j = 0; j < lp->n; j++)
+		value[k] += lp->obj[j] * lp->x[j];
+	if (cstat && rstat)
+		lp_simplex_solver_get_basis(lp, cstat + (size_t)k * lp->n, rstat + (size_t)k * lp->m);
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+/* Set rhs (or objective) b + lam * d of the parametric LP
+ */
+static void rev_param_set(struct lp_simplex_Solver *lp, const double *data0, const double *drhs,
+				const double *dobj, const double lam)
+{
+	int i, j;
+
+	for (i = 0; drhs && i < lp->m; i++)
+		lp->rhs[i] = data0[i] + lam * drhs[i];
+	for (j = 0; dobj && j < lp->n; j++)
+		lp->obj[j] = data0[j] + lam * dobj[j];
+}
+
+int lp_simplex_solver_parametric(struct lp_simplex_Solver *solver, const double *drhs, const double *dobj,
+				const double lmax, const int maxbp, const int niter,
+				double *lambda, double *value, int *cstat, int *rstat, int *nbp, int *code)
+{
+	int j, p = -1, q = -1, dir = 1, piv, epoch = 0, state = lp_simplex_EXIT_SUCCESS;
+	double lam = 0., t, lo, step, v, *data0, *de, *w;
+
+	assert(solver != NULL);
+	assert((drhs == NULL) != (dobj == NULL));
+	assert(maxbp >= 1);
+	assert(lambda != NULL);
+	assert(value != NULL);
+	assert(nbp != NULL);
+	assert(code != NULL);
+
+	*nbp = 0;
+	data0 = (double *)rev_malloc((solver->n + solver->m) * sizeof(double));
+	if (data0 == NULL) {
+		*code = lp_simplex_MemoryAllocError;
+		return lp_simplex_EXIT_FAILURE;
+	}
+	if (lp_simplex_solver_solve(solver, niter, data0, &v, code) == lp_simplex_EXIT_FAILURE) {
+		lp_simplex_free(data0);
+		return lp_simplex_EXIT_FAILURE;
+	}
+	lp_simplex_memcpy(data0, drhs ? solver->rhs : solver->obj, (drhs ? solver->m : solver->n) * sizeof(double));
+	rev_dse_init(solver);
+	de = solver->alpha;
+	w = solver->w;
+	rev_param_record(solver, lam, maxbp, nbp, lambda, value, cstat, rstat);
+	*code = lp_simplex_Success;
+	while (1) {
+		/* largest step of lam with the current basis */
+		if (drhs) {
+			lp_simplex_memcpy(w, drhs, solver->m * sizeof(double));
+			rev_ftran(solver, w);
+			p = rev_range_primal(solver, w, &lo, &t);
+			dir = p >= 0 && w[p] > 0. ? 1 : -1;  /* `w` is overwritten by the refactorization */
+		} else {
+			for (j = 0; j < solver->n; j++)
+				solver->obj[j] = dobj[j];
+			rev_phase_2_cost(solver);
+			rev_price(solver);
+			lp_simplex_memcpy(de, solver->d, solver->ncol * sizeof(double));
+			rev_param_set(solver, data0, drhs, dobj, lam);
+			rev_phase_2_cost(solver);
+			rev_price(solver);
+			q = rev_param_obj_step(solver, de, &t, &dir);
+		}
+		t = __lp_simplex_MAX__(t, 0.);
+		lam = lam + t < lmax ? lam + t : lmax;
+		rev_param_set(solver, data0, drhs, dobj, lam);
+		if (drhs && rev_refactor(solver) == lp_simplex_EXIT_FAILURE) {
+			state = rev_code(4, code);
+			break;
+		}
+		if (lam == lmax) {
+			if (rev_param_record(solver, lam, maxbp, nbp, lambda, value, cstat, rstat) == lp_simplex_EXIT_FAILURE)
+				*code = lp_simplex_ExceedIterLimit;
+			break;
+		}
+		if (++epoch > niter) {
+			*code = lp_simplex_ExceedIterLimit;
+			break;
+		}
+
+		/* pivot to the basis of the next piece: the blocking basic variable
+		 * leaves (rhs) or the column of the reduced cost changing sign enters */
+		if (drhs) {
+			rev_phase_2_cost(solver);
+			piv = rev_dual_pivot(solver, p, dir * __lp_simplex_REV_FEASIBLE__);
+			if (piv == 3) {  /* infeasible beyond lam */
+				rev_refactor(solver);
+				rev_param_record(solver, lam, maxbp, nbp, lambda, value, cstat, rstat);
+				*code = lp_simplex_Infeasibility;
+				break;
+			}
+		} else {
+			rev_column(solver, q, w);
+			rev_ftran(solver, w);
+			p = rev_leave_rule(solver, q, dir, 1, &step);
+			if (p == -2) {  /* unbounded beyond lam */
+				rev_param_record(solver, lam, maxbp, nbp, lambda, value, cstat, rstat);
+				*code = lp_simplex_Unboundedness;
+				break;
+			}
+			rev_update(solver, q, p, dir, step);
+			piv = 0;
+		}
+		if (piv != 0 || rev_refactor(solver) == lp_simplex_EXIT_FAILURE) {
+			state = rev_code(4, code);
+			break;
+		}
+		if (rev_param_record(solver, lam, maxbp, nbp, lambda, value, cstat, rstat) == lp_simplex_EXIT_FAILURE) {
+			*code = lp_simplex_ExceedIterLimit;
+			break;
+		}
+	}
+
+	/* back to the LP at lam = 0, from the basis of the last breakpoint */
+	rev_param_set(solver, data0, drhs, dobj, 0.);
+	solver->solved = state == lp_simplex_EXIT_SUCCESS && rev_refactor(solver) == lp_simplex_EXIT_SUCCESS;
+	lp_simplex_free(data0);
+	return state;
+}
+
+int lp_simplex_rev(const double *objective, const struct optm_LinearConstraint *constraints,
+			const struct optm_VariableBound *bounds,
+			const int m, const int n, const int niter,
+			double *x, double *value, int *code)
+{
+	struct lp_simplex_Solver *solver;
+	int state;
+
+	assert(code != NULL);
+
+	solver = lp_simplex_solver_create(objective, constraints, bounds, m, n);
+	if (solver == NULL) {
+		*code = lp_simplex_MemoryAllocError;
+		return lp_simplex_EXIT_FAILURE;
+	}
+	state = lp_simplex_solver_solve(solver, niter, x, value, code);
+	lp_simplex_solver_free(solver);
+	return state;
+}
+
+int lp_simplex_multi(const double *objective, const struct optm_LinearConstraint *constraints,
+			const struct optm_VariableBound *bounds, const int m, const int n,
+			const int nscen, const double *rhs, const double *objectives, const int niter,
+			double *x, double *value, int *code)
+{
+	struct lp_simplex_Solver *solver;
+	int i, j, k, *stat, saved = 0, state = lp_simplex_EXIT_SUCCESS;
+
+	assert(objective != NULL || objectives != NULL);
+	assert(x != NULL);
+	assert(value != NULL);
+	assert(code != NULL);
+
+	solver = lp_simplex_solver_create(objectives ? objectives : objective, constraints, bounds, m, n);
+	stat = (int *)rev_malloc((n + m) * sizeof(int));  /* last optimal basis: columns, then rows */
+	if (solver == NULL || stat == NULL) {
+		lp_simplex_solver_free(solver);
+		lp_simplex_free(stat);
+		for (k = 0; k < nscen; k++)
+			code[k] = lp_simplex_MemoryAllocError;
+		return lp_simplex_EXIT_FAILURE;
+	}
+	for (k = 0; k < nscen; k++) {
+		for (i = 0; rhs && i < m; i++)
+			lp_simplex_solver_set_rhs(solver, i, rhs[i + k * m]);
+		for (j = 0; objectives && j < n; j++)
+			lp_simplex_solver_set_objective(solver, j, objectives[j + k * n]);
+		if (!solver->solved && saved)  /* restart from the last optimal basis */
+			lp_simplex_solver_set_basis(solver, stat, stat + n);
+		if (lp_simplex_solver_solve(solver, niter, x + k * n, value + k, code + k) == lp_simplex_EXIT_FAILURE) {
+			state = lp_simplex_EXIT_FAILURE;
+			continue;
+		}
+		saved = lp_simplex_solver_get_basis(solver, stat, stat + n) == lp_simplex_EXIT_SUCCESS;
+	}
+	lp_simplex_free(stat);
+	lp_simplex_solver_free(solver);
+	return state;
+}
+
+int lp_simplex_ranging(const double *objective, const struct optm_LinearConstraint *constraints,
+			const struct optm_VariableBound *bounds, const int m, const int n, const int niter,
+			double *x, double *value, int *code, struct lp_simplex_Ranging *rg)
+{
+	struct lp_simplex_Solver *solver;
+	int state;
+
+	assert(code != NULL);
+
+	solver = lp_simplex_solver_create(objective, constraints, bounds, m, n);
+	if (solver == NULL) {
+		*code = lp_simplex_MemoryAllocError;
+		return lp_simplex_EXIT_FAILURE;
+	}
+	state = lp_simplex_solver_solve(solver, niter, x, value, code);
+	if (state == lp_simplex_EXIT_SUCCESS)
+		state = lp_simplex_solver_ranging(solver, rg);
+	lp_simplex_solver_free(solver);
+	return state;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <limits.h>
+#include <math.h>
+#include <lp_simplex/lp_simplex_utils.h>
+#include <lp_simplex/lp_simplex.h>
+
+/* Maximum passes of the geometric mean scaling */
+#define __lp_simplex_SCALE_PASSES__		8
+
+/* Floor of x / 2 (also for negative x)
+ */
+static int scale_half(const int x)
+{
+	return x >= 0 ? x / 2 : -((1 - x) / 2);
+}
+
+/* Range [*lo, *hi] of the exponents of a row (`step` 1) or a column (`step`
+ * n) of `expo`, scaled by the exponents `other` of the columns (or rows)
+ * only; return 0 if the row or column is empty
+ */
+static int scale_span(const int *expo, const int *other, const int len, const int step, int *lo, int *hi)
+{
+	int k, any = 0;
+
+	for (k = 0; k < len; k++) {
+		int e;
+
+		if (expo[k * step] == INT_MIN)
+			continue;
+		e = expo[k * step] + other[k];
+		if (!any || e < *lo)
+			*lo = e;
+		if (!any || e > *hi)
+			*hi = e;
+		any = 1;
+	}
+	return any;
+}
+
+int lp_simplex_scale(const struct optm_LinearConstraint *constraints, const int m, const int n,
+			double *rowscale, double *colscale)
+{
+	int i, j, pass, changed, lo = 0, hi = 0;
+	int *expo, *rexp, *cexp;
+
+	assert(constraints != NULL);
+	assert(rowscale != NULL);
+	assert(colscale != NULL);
+
+	expo = (int *)lp_simplex_malloc(((size_t)m * n + 1) * sizeof(int));
+	rexp = (int *)lp_simplex_malloc((m + 1) * sizeof(int));
+	cexp = (int *)lp_simplex_malloc((n + 1) * sizeof(int));
+	if (!expo || !rexp || !cexp) {
+		lp_simplex_free(expo);
+		lp_simplex_free(rexp);
+		lp_simplex_free(cexp);
+		return lp_simplex_EXIT_FAILURE;
+	}
+	/* every scale factor is a power of 2, so that only exponents change
+	 * and the scaled LP is exact */
+	for (i = 0; i < m; i++) {
+		for (j = 0; j < n; j++) {
+			double a = constraints[i].coef[j];
+
+			expo[j + i * n] = INT_MIN;
+			if (a != 0.)
+				frexp(a, expo + j + i * n);
+		}
+	}
+	lp_simplex_memset(rexp, 0, m * sizeof(int));
+	lp_simplex_memset(cexp, 0, n * sizeof(int));
+
+	/* geometric mean: the largest and smallest entries of every row (then
+	 * column) are centered around 1 */
+	for (pass = 0, changed = 1; changed && pass < __lp_simplex_SCALE_PASSES__; pass++) {
+		changed = 0;
+		for (i = 0; i < m; i++) {
+			if (scale_span(expo + i * n, cexp, n, 1, &lo, &hi) && rexp[i] != -scale_half(lo + hi)) {
+				rexp[i] = -scale_half(lo + hi);
+				changed = 1;
+			}
+		}
+		for (j = 0; j < n; j++) {
+			if (scale_span(expo + j, rexp, m, n, &lo, &hi) && cexp[j] != -scale_half(lo + hi)) {
+				cexp[j] = -scale_half(lo + hi);
+				changed = 1;
+			}
+		}
+	}
+	/* equilibration: the largest entry of every row (then column) in [1, 2) */
+	for (i = 0; i < m; i++) {
+		if (scale_span(expo + i * n, cexp, n, 1, &lo, &hi))
+			rexp[i] = 1 - hi;
+	}
+	for (j = 0; j < n; j++) {
+		if (scale_span(expo + j, rexp, m, n, &lo, &hi))
+			cexp[j] = 1 - hi;
+	}
+	for (i = 0; i < m; i++)
+		rowscale[i] = ldexp(1., rexp[i]);
+	for (j = 0; j < n; j++)
+		colscale[j] = ldexp(1., cexp[j]);
+	lp_simplex_free(expo);
+	lp_simplex_free(rexp);
+	lp_simplex_free(cexp);
+	return lp_simplex_EXIT_SUCCESS;
+}
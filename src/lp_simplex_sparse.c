@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex_utils.h>
+#include <lp_simplex/lp_simplex.h>
+
+/* Initial capacity of rows, columns and triplets (doubled when full) */
+#define __lp_simplex_SPARSE_CAP__		16
+
+static void sparse_free_compressed(struct lp_SparseModel *model)
+{
+	lp_simplex_free(model->colbeg);
+	lp_simplex_free(model->rowidx);
+	lp_simplex_free(model->colval);
+	lp_simplex_free(model->rowbeg);
+	lp_simplex_free(model->colidx);
+	lp_simplex_free(model->rowval);
+	model->colbeg = NULL;
+	model->rowidx = NULL;
+	model->colval = NULL;
+	model->rowbeg = NULL;
+	model->colidx = NULL;
+	model->rowval = NULL;
+	model->compressed = 0;
+	model->nz = 0;
+}
+
+void lp_simplex_sparse_free(struct lp_SparseModel *model)
+{
+	if (model == NULL)
+		return;
+	sparse_free_compressed(model);
+	lp_simplex_free(model->objective);
+	lp_simplex_free(model->constraints);
+	lp_simplex_free(model->bounds);
+	lp_simplex_free(model->trirow);
+	lp_simplex_free(model->tricol);
+	lp_simplex_free(model->trival);
+	lp_simplex_free(model);
+}
+
+struct lp_SparseModel *lp_simplex_sparse_create(void)
+{
+	struct lp_SparseModel *model;
+	int cap = __lp_simplex_SPARSE_CAP__;
+
+	model = (struct lp_SparseModel *)lp_simplex_malloc(sizeof(struct lp_SparseModel));
+	if (model == NULL)
+		return NULL;
+	lp_simplex_memset(model, 0, sizeof(struct lp_SparseModel));
+	model->objective = (double *)lp_simplex_malloc(cap * sizeof(double));
+	model->constraints = lp_simplex_malloc(cap * sizeof(struct optm_LinearConstraint));
+	model->bounds = lp_simplex_malloc(cap * sizeof(struct optm_VariableBound));
+	model->trirow = (int *)lp_simplex_malloc(cap * sizeof(int));
+	model->tricol = (int *)lp_simplex_malloc(cap * sizeof(int));
+	model->trival = (double *)lp_simplex_malloc(cap * sizeof(double));
+	if (!model->objective || !model->constraints || !model->bounds
+	    || !model->trirow || !model->tricol || !model->trival) {
+		lp_simplex_sparse_free(model);
+		return NULL;
+	}
+	model->mcap = cap;
+	model->ncap = cap;
+	model->nnzcap = cap;
+	return model;
+}
+
+/* Double the capacity of `*arr` (elements of `size` bytes) from `cap`
+ */
+static int sparse_grow(void **arr, const int cap, const size_t size)
+{
+	void *tmp = lp_simplex_realloc(*arr, 2 * (size_t)cap * size);
+
+	if (tmp == NULL)
+		return lp_simplex_EXIT_FAILURE;
+	*arr = tmp;
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+static void sparse_set_name(char *dest, const char *name)
+{
+	size_t len = name ? lp_simplex_strlen(name) : 0;
+
+	lp_simplex_memset(dest, '\0', 8);
+	lp_simplex_memcpy(dest, name, __lp_simplex_MIN__(len, 8));
+}
+
+int lp_simplex_sparse_add_coef(struct lp_SparseModel *model, const int i, const int j, const double value)
+{
+	assert(model != NULL);
+	assert(0 <= i && i < model->m);
+	assert(0 <= j && j < model->n);
+
+	if (model->nnz == model->nnzcap) {
+		if (sparse_grow((void **)&model->trirow, model->nnzcap, sizeof(int)) == lp_simplex_EXIT_FAILURE
+		    || sparse_grow((void **)&model->tricol, model->nnzcap, sizeof(int)) == lp_simplex_EXIT_FAILURE
+		    || sparse_grow((void **)&model->trival, model->nnzcap, sizeof(double)) == lp_simplex_EXIT_FAILURE)
+			return lp_simplex_EXIT_FAILURE;
+		model->nnzcap *= 2;
+	}
+	model->trirow[model->nnz] = i;
+	model->tricol[model->nnz] = j;
+	model->trival[model->nnz] = value;
+	model->nnz++;
+	model->compressed = 0;
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+int lp_simplex_sparse_add_row(struct lp_SparseModel *model, const char *name, const int type, const double rhs,
+				const int nz, const int *idx, const double *val)
+{
+	int k, i;
+
+	assert(model != NULL);
+
+	if (model->m == model->mcap) {
+		if (sparse_grow((void **)&model->constraints, model->mcap,
+				sizeof(struct optm_LinearConstraint)) == lp_simplex_EXIT_FAILURE)
+			return -1;
+		model->mcap *= 2;
+	}
+	i = model->m++;
+	sparse_set_name(model->constraints[i].name, name);
+	model->constraints[i].coef = NULL;
+	model->constraints[i].rhs = rhs;
+	model->constraints[i].type = type;
+	model->compressed = 0;
+	for (k = 0; k < nz; k++) {
+		if (lp_simplex_sparse_add_coef(model, i, idx[k], val[k]) == lp_simplex_EXIT_FAILURE)
+			return -1;
+	}
+	return i;
+}
+
+int lp_simplex_sparse_add_col(struct lp_SparseModel *model, const char *name, const double obj,
+				const int b_type, const double lb, const double ub,
+				const int nz, const int *idx, const double *val)
+{
+	int k, j;
+
+	assert(model != NULL);
+
+	if (model->n == model->ncap) {
+		if (sparse_grow((void **)&model->objective, model->ncap, sizeof(double)) == lp_simplex_EXIT_FAILURE
+		    || sparse_grow((void **)&model->bounds, model->ncap,
+				   sizeof(struct optm_VariableBound)) == lp_simplex_EXIT_FAILURE)
+			return -1;
+		model->ncap *= 2;
+	}
+	j = model->n++;
+	model->objective[j] = obj;
+	sparse_set_name(model->bounds[j].name, name);
+	model->bounds[j].lb = lb;
+	model->bounds[j].ub = ub;
+	model->bounds[j].b_type = b_type;
+	model->bounds[j].v_type = optm_VAR_T_REAL;
+	model->compressed = 0;
+	for (k = 0; k < nz; k++) {
+		if (lp_simplex_sparse_add_coef(model, idx[k], j, val[k]) == lp_simplex_EXIT_FAILURE)
+			return -1;
+	}
+	return j;
+}
+
+/* Counting sort of the entries (key, idx, val) of `nnz` entries by `key`
+ * (stable), giving the pointers `beg` (length nkey + 1) and the sorted
+ * `outidx` and `outval`
+ */
+static void sparse_bucket(const int *key, const int *idx, const double *val, const int nnz, const int nkey,
+			  int *beg, int *outidx, double *outval, int *next)
+{
+	int k, c;
+
+	lp_simplex_memset(beg, 0, (nkey + 1) * sizeof(int));
+	for (k = 0; k < nnz; k++)
+		beg[key[k] + 1]++;
+	for (c = 0; c < nkey; c++)
+		beg[c + 1] += beg[c];
+	lp_simplex_memcpy(next, beg, nkey * sizeof(int));
+	for (k = 0; k < nnz; k++) {
+		int pos = next[key[k]]++;
+
+		outidx[pos] = idx[k];
+		outval[pos] = val[k];
+	}
+}
+
+int lp_simplex_sparse_compress(struct lp_SparseModel *model)
+{
+	int i, j, k, nz, m, n, nnz;
+	int *rowkey = NULL, *next = NULL;
+
+	assert(model != NULL);
+
+	if (model->compressed)
+		return lp_simplex_EXIT_SUCCESS;
+	sparse_free_compressed(model);
+	m = model->m;
+	n = model->n;
+	nnz = model->nnz;
+	model->colbeg = (int *)lp_simplex_malloc((n + 1) * sizeof(int));
+	model->rowidx = (int *)lp_simplex_malloc((nnz + 1) * sizeof(int));
+	model->colval = (double *)lp_simplex_malloc((nnz + 1) * sizeof(double));
+	model->rowbeg = (int *)lp_simplex_malloc((m + 1) * sizeof(int));
+	model->colidx = (int *)lp_simplex_malloc((nnz + 1) * sizeof(int));
+	model->rowval = (double *)lp_simplex_malloc((nnz + 1) * sizeof(double));
+	rowkey = (int *)lp_simplex_malloc((nnz + 1) * sizeof(int));
+	next = (int *)lp_simplex_malloc((__lp_simplex_MAX__(m, n) + 1) * sizeof(int));
+	if (!model->colbeg || !model->rowidx || !model->colval || !model->rowbeg
+	    || !model->colidx || !model->rowval || !rowkey || !next)
+		goto FAIL;
+
+	/* by row (stable), then by column: columns hold increasing rows */
+	sparse_bucket(model->trirow, model->tricol, model->trival, nnz, m, model->rowbeg,
+		      model->colidx, model->rowval, next);
+	for (i = 0; i < m; i++) {
+		for (k = model->rowbeg[i]; k < model->rowbeg[i + 1]; k++)
+			rowkey[k] = i;
+	}
+	sparse_bucket(model->colidx, rowkey, model->rowval, nnz, n, model->colbeg,
+		      model->rowidx, model->colval, next);
+
+	/* sum duplicates (adjacent in a column) and drop zeros */
+	nz = 0;
+	for (j = 0; j < n; j++) {
+		int beg = model->colbeg[j];
+
+		model->colbeg[j] = nz;
+		for (k = beg; k < model->colbeg[j + 1]; k++) {
+			double a = model->colval[k];
+
+			while (k + 1 < model->colbeg[j + 1] && model->rowidx[k + 1] == model->rowidx[k])
+				a += model->colval[++k];
+			if (a != 0.) {
+				model->rowidx[nz] = model->rowidx[k];
+				model->colval[nz] = a;
+				nz++;
+			}
+		}
+	}
+	model->colbeg[n] = nz;
+	model->nz = nz;
+
+	/* rows from the compressed columns: rows hold increasing columns */
+	for (j = 0; j < n; j++) {
+		for (k = model->colbeg[j]; k < model->colbeg[j + 1]; k++)
+			rowkey[k] = j;
+	}
+	sparse_bucket(model->rowidx, rowkey, model->colval, nz, m, model->rowbeg,
+		      model->colidx, model->rowval, next);
+	lp_simplex_free(rowkey);
+	lp_simplex_free(next);
+	model->compressed = 1;
+	return lp_simplex_EXIT_SUCCESS;
+FAIL:
+	lp_simplex_free(rowkey);
+	lp_simplex_free(next);
+	sparse_free_compressed(model);
+	return lp_simplex_EXIT_FAILURE;
+}
+
+int lp_simplex_sparse(struct lp_SparseModel *model, const char *criteria, const int niter,
+			const struct lp_simplex_Options *opts,
+			double *x, double *value, int *code)
+{
+	struct lp_simplex_Solver *solver;
+	struct lp_Model *dense;
+	int state;
+
+	assert(model != NULL);
+	assert(code != NULL);
+
+	if (7 == lp_simplex_strlen(criteria) && 0 == lp_simplex_memcmp("revised", criteria, 7)
+	    && (opts == NULL || (!opts->presolve && !opts->scaling))) {
+		solver = lp_simplex_solver_create_sparse(model);
+		if (solver == NULL) {
+			*code = lp_simplex_MemoryAllocError;
+			return lp_simplex_EXIT_FAILURE;
+		}
+		state = lp_simplex_solver_solve(solver, niter, x, value, code);
+		lp_simplex_solver_free(solver);
+		return state;
+	}
+	dense = lp_simplex_sparse_to_dense(model);
+	if (dense == NULL) {
+		*code = lp_simplex_MemoryAllocError;
+		return lp_simplex_EXIT_FAILURE;
+	}
+	state = lp_simplex_opt(dense->objective, dense->constraints, dense->bounds, dense->m, dense->n,
+			       criteria, niter, opts, x, value, code);
+	lp_simplex_model_free(dense);
+	return state;
+}
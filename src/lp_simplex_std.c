@@ -8,41 +8,67 @@
 /* Checker of the checking "LP is feasible" */
 #define __lp_simplex_FEASIBLE__			1e-5
 
-/* To create in heap (need to be released) simplex table, index set of basis
- * and constraint type recorder
+/* Doubles per `__lp_simplex_ALIGN__` bytes (the row length is a multiple of it) */
+#define __lp_simplex_TABLE_LANES__		((int)(__lp_simplex_ALIGN__ / sizeof(double)))
+
+/* Smallest pivot element of the crash basis */
+#define __lp_simplex_CRASH_PIVOT__		1e-3
+
+static void free_buffer(struct lp_simplex_Workspace *ws, double *table, int *basis,
+			struct lp_simplex_BasisIndex *idx, struct lp_simplex_Bounds *bd, int *constypes)
+{
+	lp_simplex_ws_free(ws, table);
+	lp_simplex_ws_free(ws, basis);
+	lp_simplex_ws_free(ws, idx->bpos);
+	lp_simplex_ws_free(ws, bd->lb);
+	lp_simplex_ws_free(ws, bd->flip);
+	lp_simplex_ws_free(ws, constypes);
+}
+
+/* To create in heap (need to be released) or take from workspace `ws` the
+ * simplex table (rows of `ldtable` entries), index set of basis (with its
+ * position array and nonbasic list), column bounds (if `bounded`) and
+ * constraint type recorder
  */
-static int create_buffer(double **table, int **basis, int **constypes,
-				const int m, const int nrow, const int ncol)
+static int create_buffer(struct lp_simplex_Workspace *ws, double **table, int **basis,
+				struct lp_simplex_BasisIndex *idx, struct lp_simplex_Bounds *bd,
+				int **constypes, const int bounded, const int m, const int nrow, const int ncol,
+				const int ldtable)
 {
 	*table = NULL;
 	*basis = NULL;
 	*constypes = NULL;
+	idx->bpos = NULL;
+	bd->lb = NULL;
+	bd->ub = NULL;
+	bd->flip = NULL;
 
-	*table = (double *)lp_simplex_malloc(nrow * ncol * sizeof(double));
+	*table = (double *)lp_simplex_ws_alloc(ws, __lp_simplex_WS_TABLE__, nrow * ldtable * sizeof(double));
 	if (*table == NULL)
 		return lp_simplex_EXIT_FAILURE;
-	*basis = (int *)lp_simplex_malloc(m * sizeof(int));
-	if (*basis == NULL) {
-		lp_simplex_free(*table);
-		return lp_simplex_EXIT_FAILURE;
-	}
-	*constypes = (int *)lp_simplex_malloc(m * sizeof(int));
-	if (*constypes == NULL) {
-		lp_simplex_free(*table);
-		lp_simplex_free(*basis);
-		return lp_simplex_EXIT_FAILURE;
-	}
+	*basis = (int *)lp_simplex_ws_alloc(ws, __lp_simplex_WS_BASIS__, m * sizeof(int));
+	if (*basis == NULL)
+		goto FAIL;
+	idx->bpos = (int *)lp_simplex_ws_alloc(ws, __lp_simplex_WS_BPOS__, 2 * ncol * sizeof(int));
+	if (idx->bpos == NULL)
+		goto FAIL;
+	idx->nonbasic = idx->bpos + ncol;
+	*constypes = (int *)lp_simplex_ws_alloc(ws, __lp_simplex_WS_CONSTYPES__, m * sizeof(int));
+	if (*constypes == NULL)
+		goto FAIL;
+	if (!bounded)
+		return lp_simplex_EXIT_SUCCESS;
+	bd->lb = (double *)lp_simplex_ws_alloc(ws, __lp_simplex_WS_BOUNDS__, 2 * ncol * sizeof(double));
+	if (bd->lb == NULL)
+		goto FAIL;
+	bd->ub = bd->lb + ncol;
+	bd->flip = (int *)lp_simplex_ws_alloc(ws, __lp_simplex_WS_FLIP__, ncol * sizeof(int));
+	if (bd->flip == NULL)
+		goto FAIL;
 	return lp_simplex_EXIT_SUCCESS;
-}
-
-static void free_buffer(double *table, int *basis, int *constypes)
-{
-	if (table)
-		lp_simplex_free(table);
-	if (basis)
-		lp_simplex_free(basis);
-	if (constypes)
-		lp_simplex_free(constypes);
+FAIL:
+	free_buffer(ws, *table, *basis, idx, bd, *constypes);
+	return lp_simplex_EXIT_FAILURE;
 }
 
 /* Fill in constraint type array from "constraints"
@@ -161,6 +187,24 @@ static int add_artif(double *table, const int ldtable, const int *constypes,
 	return nartif;
 }
 
+/* Fill in column bounds: structural columns take `lb` and `ub`, the others are
+ * nonnegative (`NULL` bounds are 0 and `INF`)
+ */
+static void fill_bounds(struct lp_simplex_Bounds *bd, const double *lb, const double *ub,
+			const int n, const int nvar)
+{
+	int j;
+
+	bd->nfree = 0;
+	for (j = 0; j < nvar; j++) {
+		bd->lb[j] = j < n && lb ? lb[j] : 0.;
+		bd->ub[j] = j < n && ub ? ub[j] : __lp_simplex_INF__;
+		bd->flip[j] = 0;
+		if (bd->lb[j] == __lp_simplex_NINF__)
+			bd->nfree++;
+	}
+}
+
 /* Fill in the basis index set of artificial LP
  */
 static void fill_artiflp_basis(int *basis, const int *constypes,
@@ -201,32 +245,42 @@ static void fill_artiflp_nrcost(double *table, const int ldtable, const int *con
 	}
 }
 
-static void transf_artif_basis(double *table, int ldtable, int *basis, const int m, const int nreal, int nvar)
+/* Drive artificial variables out of the basis after phase 1
+ *
+ * Rows whose real columns are all zero are redundant and cleared
+ */
+static void transf_artif_basis(double *table, int ldtable, int *basis, struct lp_simplex_BasisIndex *idx,
+				const int m, const int nreal, int nvar)
 {
-	int i, j, q = nvar;
-	double ele, maxv = __lp_simplex_NINF__;
+	int i, j, k, q;
+	double ele, maxv;
 
-	/* basis index should not exceeds number of variables */
-	if (maxabs_arri(basis, m, 1) <= nreal)
-		return;
 	for (i = 0; i < m; i++) {
-		if (basis[i] <nreal)
+		if (basis[i] < nreal)
 			continue;
-		for (j = 0; j < nreal; j++) {
+		maxv = __lp_simplex_NINF__;
+		q = idx->nnonbasic;
+		for (k = 0; k < idx->nnonbasic; k++) {
+			j = idx->nonbasic[k];
+			if (j >= nreal)
+				continue;
 			ele = __lp_simplex_ABS__(table[j + (i + 1) * ldtable]);
 			if (ele > maxv) {
 				maxv = ele;
-				q = j;
+				q = k;
 			}
 		}
-		if (maxv < 1e-9) {
+		if (q == idx->nnonbasic || maxv < 1e-9) {
 			table[nvar + (i + 1) * ldtable] = 0.;
 			lp_simplex_memset(table + (i + 1) * ldtable, 0, nreal * sizeof(double));
 			continue;
 		}
-		lp_simplex_pivot_core(table, ldtable, m, nvar, i, q, 1, 1, 0);
-		basis[i] = q;
-		q = nvar;
+		j = idx->nonbasic[q];
+		lp_simplex_pivot_core(table, ldtable, m, nvar, i, j, 1, 1, 0);
+		idx->nonbasic[q] = basis[i];
+		idx->bpos[basis[i]] = -1;
+		idx->bpos[j] = i;
+		basis[i] = j;
 	}
 }
 
@@ -242,6 +296,67 @@ static void delete_artif_cols(double *table, const int ldtable, const int m, con
 	}
 }
 
+/* Crash basis: drive artificial variables out of the initial basis before phase 1
+ *
+ * Every artificial row i takes the nonbasic real column j with the largest
+ * y_i_j > 0 among those for which row i wins the ratio test (the value
+ * y_i_b / y_i_j of x_j within its upper bound, and no basic variable leaves
+ * its bounds), so that every crash pivot keeps the basis feasible. Then the
+ * artificial column is cleared: it can never reenter and phase 1 only works
+ * on the artificial rows that remain.
+ *
+ * Return the number of crash pivots
+ */
+static int crash_basis(double *table, const int ldtable, int *basis, struct lp_simplex_BasisIndex *idx,
+			const struct lp_simplex_Bounds *bd, const int m, const int nreal, const int nvar,
+			struct lp_simplex_Pool *pool)
+{
+	int i, j, k, q, artif, npivot = 0;
+	double best, t;
+
+	for (i = 0; i < m; i++) {
+		double *rowi = table + (i + 1) * ldtable;
+
+		if (basis[i] < nreal)
+			continue;
+		best = __lp_simplex_CRASH_PIVOT__;
+		q = -1;
+		for (j = 0; j < nreal; j++) {
+			if (idx->bpos[j] >= 0 || rowi[j] <= best || (bd && bd->flip[j]))
+				continue;
+			t = rowi[nvar] / rowi[j];
+			if (bd && t > bd->ub[j])
+				continue;
+			for (k = 0; k < m; k++) {
+				double y_k_j = table[j + (k + 1) * ldtable], b_k = table[nvar + (k + 1) * ldtable];
+
+				if (k == i || y_k_j == 0.)
+					continue;
+				if (y_k_j > 0. && b_k < t * y_k_j)
+					break;
+				if (y_k_j < 0. && bd && basis[k] < nreal && b_k - t * y_k_j > bd->ub[basis[k]])
+					break;
+			}
+			if (k == m) {
+				best = rowi[j];
+				q = j;
+			}
+		}
+		if (q < 0)
+			continue;
+		artif = basis[i];
+		lp_simplex_pivot_core_ex(table, ldtable, m, nvar, i, q, 1, 1, 1, NULL, pool);
+		for (k = 0; k < m + 1; k++)
+			table[artif + k * ldtable] = 0.;
+		idx->bpos[artif] = -1;
+		idx->bpos[q] = i;
+		basis[i] = q;
+		npivot++;
+	}
+	lp_simplex_basis_index(idx, basis, m, nvar);
+	return npivot;
+}
+
 /* Phase 1: get a BFS for the original problem using the usual way - artificial LP
  *
  * Work:
@@ -249,17 +364,21 @@ static void delete_artif_cols(double *table, const int ldtable, const int m, con
  * 	2. form a basic feasible solution (BSF)
  * 	3. assign ldtable and nvar, the number of vars in BSF
  */
-static int simplex_phase_1_usul(double **table, int *ldtable, int **basis, int **constypes,
-				int *nvar, int *epoch, int *code,
-				const struct optm_LinearConstraint *constraints,
-				const int m, const int n, const char *criteria, const int niter)
+static int simplex_phase_1_usul(double **table, int *ldtable, int **basis,
+				struct lp_simplex_BasisIndex *idx, struct lp_simplex_Bounds *bd,
+				int **constypes, int *nvar, int *epoch, int *code,
+				const struct optm_LinearConstraint *constraints, const double *lb, const double *ub,
+				const int m, const int n, const char *criteria, const int niter,
+				const int crash, struct lp_simplex_Pool *pool, struct lp_simplex_Workspace *ws)
 {
 	int nrow, ncol;
 	int nslack, nartif;
 
 	table_size_usul(constraints, m, n, &nrow, &ncol);
-	*ldtable = ncol;  /* leading dimension of table in memory */
-	if (create_buffer(table, basis, constypes, m, nrow, *ldtable) == lp_simplex_EXIT_FAILURE) {
+	/* leading dimension of table in memory: every row starts on `__lp_simplex_ALIGN__` bytes */
+	*ldtable = ncol + (__lp_simplex_TABLE_LANES__ - ncol % __lp_simplex_TABLE_LANES__) % __lp_simplex_TABLE_LANES__;
+	if (create_buffer(ws, table, basis, idx, bd, constypes, lb || ub, m, nrow, ncol, *ldtable)
+	    == lp_simplex_EXIT_FAILURE) {
 		*code = lp_simplex_MemoryAllocError;
 		return lp_simplex_EXIT_FAILURE;
 	}
@@ -275,8 +394,14 @@ static int simplex_phase_1_usul(double **table, int *ldtable, int **basis, int *
 	}
 	fill_artiflp_basis(*basis, *constypes, m, n, nslack);
 	fill_artiflp_nrcost(*table, *ldtable, *constypes, m, ncol);
-
-	switch (lp_simplex_bsc(epoch, *table, *ldtable, *basis, m, *nvar, n + nslack, criteria, niter)) {
+	lp_simplex_basis_index(idx, *basis, m, *nvar);
+	if (bd->lb)
+		fill_bounds(bd, lb, ub, n, *nvar);
+	if (crash)
+		crash_basis(*table, *ldtable, *basis, idx, bd->lb ? bd : NULL, m, n + nslack, *nvar, pool);
+
+	switch (lp_simplex_bsc_ex(epoch, *table, *ldtable, *basis, idx, bd->lb ? bd : NULL,
+				  m, *nvar, n + nslack, criteria, niter, pool, ws)) {
 	case 0:
 		*code = lp_simplex_ExceedIterLimit;
 		goto END;
@@ -285,9 +410,10 @@ static int simplex_phase_1_usul(double **table, int *ldtable, int **basis, int *
 			*code = lp_simplex_Infeasibility;
 			goto END;
 		}
-		transf_artif_basis(*table, *ldtable, *basis, m, n + nslack, *nvar);
+		transf_artif_basis(*table, *ldtable, *basis, idx, m, n + nslack, *nvar);
 		delete_artif_cols(*table, *ldtable, m, n + nslack, nartif);
 		*nvar = n + nslack;
+		lp_simplex_basis_index(idx, *basis, m, *nvar);  /* drop artificial columns */
 		return lp_simplex_EXIT_SUCCESS;
 	case 2:
 		*code = lp_simplex_Unboundedness;
@@ -295,22 +421,27 @@ static int simplex_phase_1_usul(double **table, int *ldtable, int **basis, int *
 	case 3:
 		*code = lp_simplex_Degeneracy;
 		goto END;
+	case 4:
+		*code = lp_simplex_MemoryAllocError;
+		goto END;
 	case 9:
 		*code = lp_simplex_PrecisionError;
 		goto END;
 	}
 END:
-	free_buffer(*table, *basis, *constypes);
+	free_buffer(ws, *table, *basis, idx, bd, *constypes);
 	return lp_simplex_EXIT_FAILURE;
 }
 
 /* Phase 2: Solve the original problem
  */
-static int simplex_phase_2_usul(double *table, int ldtable, int *basis, int *constypes,
-				int *epoch, int *code, const int m, const int n,
-				const int nvar, const char *criteria, const int niter)
+static int simplex_phase_2_usul(double *table, int ldtable, int *basis, struct lp_simplex_BasisIndex *idx,
+				struct lp_simplex_Bounds *bd, int *constypes, int *epoch, int *code,
+				const int m, const int n, const int nvar, const char *criteria, const int niter,
+				struct lp_simplex_Pool *pool, struct lp_simplex_Workspace *ws)
 {
-	switch (lp_simplex_bsc(epoch, table, ldtable, basis, m, nvar, nvar, criteria, niter)) {
+	switch (lp_simplex_bsc_ex(epoch, table, ldtable, basis, idx, bd->lb ? bd : NULL,
+				  m, nvar, nvar, criteria, niter, pool, ws)) {
 	case 0:
 		*code = lp_simplex_ExceedIterLimit;
 		goto END;
@@ -323,17 +454,50 @@ static int simplex_phase_2_usul(double *table, int ldtable, int *basis, int *con
 	case 3:
 		*code = lp_simplex_Degeneracy;
 		goto END;
+	case 4:
+		*code = lp_simplex_MemoryAllocError;
+		goto END;
 	case 9:
 		*code = lp_simplex_PrecisionError;
 		goto END;
 	}
 END:
-	free_buffer(table, basis, constypes);
+	free_buffer(ws, table, basis, idx, bd, constypes);
 	return lp_simplex_EXIT_FAILURE;  /* error code already updated */
 }
 
-int lp_simplex_std(const double *objective, const struct optm_LinearConstraint *constraints,
-			const int m, const int n, const char *criteria, const int niter,
+/* Convert bounds `lb` and `ub` into variable bounds for `lp_simplex_rev`
+ */
+static int simplex_std_rev(const double *objective, const struct optm_LinearConstraint *constraints,
+			const double *lb, const double *ub, const int m, const int n, const int niter,
+			double *x, double *value, int *code)
+{
+	int j, state;
+	struct optm_VariableBound *bounds;
+
+	if (lb == NULL && ub == NULL)
+		return lp_simplex_rev(objective, constraints, NULL, m, n, niter, x, value, code);
+	bounds = (struct optm_VariableBound *)lp_simplex_malloc(n * sizeof(struct optm_VariableBound));
+	if (bounds == NULL) {
+		*code = lp_simplex_MemoryAllocError;
+		return lp_simplex_EXIT_FAILURE;
+	}
+	for (j = 0; j < n; j++) {
+		bounds[j].lb = 0.;
+		bounds[j].ub = ub ? ub[j] : __lp_simplex_INF__;
+		if (lb && lb[j] == __lp_simplex_NINF__)
+			bounds[j].b_type = optm_BOUND_T_FR;
+		else
+			bounds[j].b_type = bounds[j].ub < __lp_simplex_INF__ ? optm_BOUND_T_UP : optm_BOUND_T_LO;
+	}
+	state = lp_simplex_rev(objective, constraints, bounds, m, n, niter, x, value, code);
+	lp_simplex_free(bounds);
+	return state;
+}
+
+int lp_simplex_std_bnd(const double *objective, const struct optm_LinearConstraint *constraints,
+			const double *lb, const double *ub, const int m, const int n, const char *criteria,
+			const int niter, const struct lp_simplex_Options *opts,
 			double *x, double *value, int *code)
 {
 	int i, j;
@@ -343,6 +507,10 @@ int lp_simplex_std(const double *objective, const struct optm_LinearConstraint *
 	int *basis = NULL;
 	double *table = NULL;
 	int *constypes = NULL;
+	struct lp_simplex_BasisIndex idx;
+	struct lp_simplex_Bounds bd;
+	struct lp_simplex_Pool *pool;
+	struct lp_simplex_Workspace *ws = opts ? opts->workspace : NULL;
 
 	assert(objective != NULL);
 	assert(constraints != NULL);
@@ -350,21 +518,38 @@ int lp_simplex_std(const double *objective, const struct optm_LinearConstraint *
 	assert(value != NULL);
 	assert(code != NULL);
 
-	if (simplex_phase_1_usul(&table, &ldtable, &basis, &constypes, &nvar, &epoch, code,
-				 constraints, m, n, criteria, niter) == lp_simplex_EXIT_FAILURE)
+	if (7 == lp_simplex_strlen(criteria) && 0 == lp_simplex_memcmp("revised", criteria, 7))
+		return simplex_std_rev(objective, constraints, lb, ub, m, n, niter, x, value, code);
+	pool = lp_simplex_ws_pool(ws, opts ? opts->nthreads : 1);  /* `NULL`: serial pivots */
+	if (simplex_phase_1_usul(&table, &ldtable, &basis, &idx, &bd, &constypes, &nvar, &epoch, code,
+				 constraints, lb, ub, m, n, criteria, niter, opts && opts->crash, pool, ws)
+	    == lp_simplex_EXIT_FAILURE) {
+		lp_simplex_ws_pool_release(ws, pool);
 		return lp_simplex_EXIT_FAILURE;
+	}
 
-	for (j = 0; j < n; j++)  /* Fill in original objective coefficients */
-		table[j] = -objective[j];
+	/* Fill in original objective coefficients (complemented columns change sign) */
+	lp_simplex_memset(table, 0, (nvar + 1) * sizeof(double));
+	for (j = 0; j < n; j++) {
+		if (bd.flip && bd.flip[j]) {
+			table[j] = objective[j];
+			if (bd.lb[j] == 0.)
+				table[nvar] += objective[j] * bd.ub[j];
+		} else
+			table[j] = -objective[j];
+	}
 	for (i = 0; i < m; i++) {  /* row_0 = row_0 - ratio * row_{i+1} */
 		int rowi = (i + 1) * ldtable;
 		double ratio = -table[basis[i]];
 
 		lp_simplex_linalg_daxpy(nvar + 1, ratio, table + rowi, 1, table, 1);
 	}
-	if (simplex_phase_2_usul(table, ldtable, basis, constypes, &epoch, code,
-				 m, n, nvar, criteria, niter) == lp_simplex_EXIT_FAILURE)
+	if (simplex_phase_2_usul(table, ldtable, basis, &idx, &bd, constypes, &epoch, code,
+				 m, n, nvar, criteria, niter, pool, ws) == lp_simplex_EXIT_FAILURE) {
+		lp_simplex_ws_pool_release(ws, pool);
 		return lp_simplex_EXIT_FAILURE;
+	}
+	lp_simplex_ws_pool_release(ws, pool);
 
 	*value = table[nvar];
 	lp_simplex_memset(x, 0., n * sizeof(double));
@@ -372,6 +557,19 @@ int lp_simplex_std(const double *objective, const struct optm_LinearConstraint *
 		if (basis[i] < n)
 			x[basis[i]] = table[nvar + (i + 1) * ldtable];
 	}
-	free_buffer(table, basis, constypes);
+	if (bd.flip) {
+		for (j = 0; j < n; j++) {
+			if (bd.flip[j])
+				x[j] = bd.lb[j] == 0. ? bd.ub[j] - x[j] : -x[j];
+		}
+	}
+	free_buffer(ws, table, basis, &idx, &bd, constypes);
 	return lp_simplex_EXIT_SUCCESS;
 }
+
+int lp_simplex_std(const double *objective, const struct optm_LinearConstraint *constraints,
+			const int m, const int n, const char *criteria, const int niter,
+			double *x, double *value, int *code)
+{
+	return lp_simplex_std_bnd(objective, constraints, NULL, NULL, m, n, criteria, niter, NULL, x, value, code);
+}
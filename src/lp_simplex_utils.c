@@ -14,12 +14,12 @@ void lp_simplex_linalg_daxpy(int n, double a, double *x, int incx, double *y, in
 	extern void daxpy_(int *n, double *alpha, double *x, int *incx, double *y, int *incy);
 	daxpy_((int *)&n, (double *)&a, (double *)x, (int *)&incx, y, (int *)&incy);
 #else
-	int i = 0, j = 0;
+	int k, i = incy >= 0 ? 0 : (1 - n) * incy, j = incx >= 0 ? 0 : (1 - n) * incx;
 
 	assert(x != NULL);
 	assert(y != NULL);
 
-	while (i < n && j < n) {
+	for (k = 0; k < n; k++) {  /* n elements at strides incx and incy */
 		y[i] += a * x[j];
 		i += incy;
 		j += incx;
@@ -33,12 +33,14 @@ void lp_simplex_linalg_dscal(int n, double x, double *arr, int inc)
 	extern void dscal_(int *n, double *alpha, double *x, int *incx);
 	dscal_(&n, &x, arr, &inc);
 #else
-	int i;
+	int k;
 
 	assert(arr != NULL);
 
-	for (i = 0; i < n; i += inc)
-		arr[i] *= x;
+	if (inc <= 0)
+		return;
+	for (k = 0; k < n; k++)  /* n elements at stride inc */
+		arr[k * inc] *= x;
 #endif
 }
 
@@ -52,6 +54,107 @@ void lp_simplex_linalg_dlarfg(int n, double *alpha, double *x, int incx, double
 #endif
 }
 
+int lp_simplex_linalg_dgetrf(int m, int n, double *a, int lda, int *ipiv)
+{
+#if USE_LAPACK
+	extern void dgetrf_(int *m, int *n, double *a, int *lda, int *ipiv, int *info);
+	int info = 0;
+
+	dgetrf_(&m, &n, a, &lda, ipiv, &info);
+	return info;
+#else
+	int i, j, k, p, mn = __lp_simplex_MIN__(m, n), info = 0;
+	double maxv, tmp;
+
+	assert(a != NULL);
+	assert(ipiv != NULL);
+
+	for (k = 0; k < mn; k++) {
+		p = k;
+		maxv = __lp_simplex_ABS__(a[k + k * lda]);
+		for (i = k + 1; i < m; i++) {
+			if (__lp_simplex_ABS__(a[i + k * lda]) > maxv) {
+				maxv = __lp_simplex_ABS__(a[i + k * lda]);
+				p = i;
+			}
+		}
+		ipiv[k] = p + 1;
+		if (maxv == 0.) {
+			if (info == 0)
+				info = k + 1;
+			continue;
+		}
+		if (p != k) {
+			for (j = 0; j < n; j++) {
+				tmp = a[k + j * lda];
+				a[k + j * lda] = a[p + j * lda];
+				a[p + j * lda] = tmp;
+			}
+		}
+		for (i = k + 1; i < m; i++)
+			a[i + k * lda] /= a[k + k * lda];
+		for (j = k + 1; j < n; j++) {
+			for (i = k + 1; i < m; i++)
+				a[i + j * lda] -= a[i + k * lda] * a[k + j * lda];
+		}
+	}
+	return info;
+#endif
+}
+
+void lp_simplex_linalg_dgetrs(char trans, int n, int nrhs, double *a, int lda, int *ipiv, double *b, int ldb)
+{
+#if USE_LAPACK
+	extern void dgetrs_(char *trans, int *n, int *nrhs, double *a, int *lda, int *ipiv,
+			    double *b, int *ldb, int *info);
+	int info = 0;
+
+	dgetrs_(&trans, &n, &nrhs, a, &lda, ipiv, b, &ldb, &info);
+#else
+	int i, k, r;
+	double tmp, *x;
+
+	assert(a != NULL);
+	assert(ipiv != NULL);
+	assert(b != NULL);
+
+	for (r = 0; r < nrhs; r++) {
+		x = b + r * ldb;
+		if (trans == 'N' || trans == 'n') {
+			for (k = 0; k < n; k++) {  /* P * b */
+				tmp = x[k];
+				x[k] = x[ipiv[k] - 1];
+				x[ipiv[k] - 1] = tmp;
+			}
+			for (k = 0; k < n; k++) {  /* L * z = P * b */
+				for (i = k + 1; i < n; i++)
+					x[i] -= a[i + k * lda] * x[k];
+			}
+			for (k = n - 1; k >= 0; k--) {  /* U * x = z */
+				x[k] /= a[k + k * lda];
+				for (i = 0; i < k; i++)
+					x[i] -= a[i + k * lda] * x[k];
+			}
+		} else {
+			for (k = 0; k < n; k++) {  /* U' * z = b */
+				for (i = 0; i < k; i++)
+					x[k] -= a[i + k * lda] * x[i];
+				x[k] /= a[k + k * lda];
+			}
+			for (k = n - 1; k >= 0; k--) {  /* L' * w = z */
+				for (i = k + 1; i < n; i++)
+					x[k] -= a[i + k * lda] * x[i];
+			}
+			for (k = n - 1; k >= 0; k--) {  /* x = P' * w */
+				tmp = x[k];
+				x[k] = x[ipiv[k] - 1];
+				x[ipiv[k] - 1] = tmp;
+			}
+		}
+	}
+#endif
+}
+
 
 int is_in_arri(const int idx, const int *idxset, const int len)
 {
@@ -66,11 +169,11 @@ int is_in_arri(const int idx, const int *idxset, const int len)
 
 int maxabs_arri(const int *arr, const int len, const int inc)
 {
-	int i, ele, maxv = __lp_simplex_NINF__;
+	int i, ele, maxv = 0;
 
 	assert(inc >= 1);
 
-	for (i = 0; i < len; i++) {
+	for (i = 0; i < len; i += inc) {
 		ele = __lp_simplex_ABS__(arr[i]);
 		if (ele > maxv)
 			maxv = ele;
@@ -85,6 +188,8 @@ int argmaxabs_arrd(const double *arr, const int len, const int inc)
 
 	assert(inc >= 1);
 
+	if (inc == 1)
+		return lp_simplex_kernel_argmaxabs(arr, len);
 	for (i = 0; i < len; i += inc) {
 		ele = __lp_simplex_ABS__(arr[i]);
 		if (ele > maxv) {
@@ -102,6 +207,8 @@ double maxabs_arrd(const double *arr, const int len, const int inc)
 
 	assert(inc >= 1);
 
+	if (inc == 1)
+		return lp_simplex_kernel_maxabs(arr, len);
 	for (i = 0; i < len; i += inc) {
 		ele = __lp_simplex_ABS__(arr[i]);
 		if (ele > maxv)
@@ -117,6 +224,8 @@ double maxabs_arrd_gap(const double *arr1, const double *arr2, const int len, co
 
 	assert(inc >= 1);
 
+	if (inc == 1)
+		return lp_simplex_kernel_maxabs_gap(arr1, arr2, len);
 	for (i = 0; i < len; i += inc) {
 		ele = __lp_simplex_ABS__(arr1[i] - arr2[i]);
 		if (ele > maxv)
@@ -206,16 +315,99 @@ void lp_simplex_prt_matd(const double *mat, const int ld, const int nrow, const
 	}
 }
 
-void *lp_simplex_malloc(size_t size)
+static void *default_malloc(void *ctx, size_t size)
 {
+	(void) ctx;
 	return malloc(size);
 }
 
-void lp_simplex_free(void *ptr)
+static void *default_realloc(void *ctx, void *ptr, size_t size)
 {
+	(void) ctx;
+	return realloc(ptr, size);
+}
+
+static void default_free(void *ctx, void *ptr)
+{
+	(void) ctx;
 	free(ptr);
 }
 
+static struct lp_simplex_Allocator allocator = {
+	default_malloc, default_realloc, default_free, NULL, NULL, NULL
+};
+
+void lp_simplex_set_allocator(const struct lp_simplex_Allocator *hooks)
+{
+	if (hooks == NULL) {
+		allocator.malloc_fn = default_malloc;
+		allocator.realloc_fn = default_realloc;
+		allocator.free_fn = default_free;
+		allocator.aligned_malloc_fn = NULL;
+		allocator.aligned_free_fn = NULL;
+		allocator.ctx = NULL;
+		return;
+	}
+	assert(hooks->malloc_fn != NULL);
+	assert(hooks->realloc_fn != NULL);
+	assert(hooks->free_fn != NULL);
+	assert((hooks->aligned_malloc_fn == NULL) == (hooks->aligned_free_fn == NULL));
+	allocator = *hooks;
+}
+
+void lp_simplex_get_allocator(struct lp_simplex_Allocator *hooks)
+{
+	assert(hooks != NULL);
+	*hooks = allocator;
+}
+
+void *lp_simplex_malloc(size_t size)
+{
+	return allocator.malloc_fn(allocator.ctx, size);
+}
+
+void *lp_simplex_realloc(void *ptr, size_t size)
+{
+	return allocator.realloc_fn(allocator.ctx, ptr, size);
+}
+
+void lp_simplex_free(void *ptr)
+{
+	if (ptr)
+		allocator.free_fn(allocator.ctx, ptr);
+}
+
+/* Without an aligned hook the block is over-allocated by `align` bytes and
+ * the pointer returned by `lp_simplex_malloc` is kept right before it
+ */
+void *lp_simplex_malloc_aligned(size_t size, size_t align)
+{
+	char *raw, *ptr;
+
+	assert(align > 0 && (align & (align - 1)) == 0);
+	if (align < sizeof(void *))
+		align = sizeof(void *);
+	if (allocator.aligned_malloc_fn)
+		return allocator.aligned_malloc_fn(allocator.ctx, size, align);
+	raw = (char *)lp_simplex_malloc(size + align + sizeof(void *));
+	if (raw == NULL)
+		return NULL;
+	ptr = raw + sizeof(void *);
+	ptr += (align - (size_t)ptr % align) % align;
+	((void **)ptr)[-1] = raw;
+	return ptr;
+}
+
+void lp_simplex_free_aligned(void *ptr)
+{
+	if (ptr == NULL)
+		return;
+	if (allocator.aligned_free_fn)
+		allocator.aligned_free_fn(allocator.ctx, ptr);
+	else
+		lp_simplex_free(((void **)ptr)[-1]);
+}
+
 void *lp_simplex_memset(void *str, int c, size_t n)
 {
 	return memset(str, c, n);
@@ -295,10 +487,10 @@ static struct lp_Model *create_model(const int m, const int n)
 
 	for (i = 0; i < m; i++) {
 		constraints[i].coef = coefficients + i * n;
-		lp_simplex_memset(constraints[i].name, '\0', 16);
+		lp_simplex_memset(constraints[i].name, '\0', 8);
 	}
 	for (i = 0; i < n; i++) {
-		lp_simplex_memset(bounds[i].name, '\0', 16);
+		lp_simplex_memset(bounds[i].name, '\0', 8);
 		bounds[i].lb = 0;
 		bounds[i].ub = __lp_simplex_INF__;
 		bounds[i].b_type = optm_BOUND_T_LO;
@@ -307,11 +499,54 @@ static struct lp_Model *create_model(const int m, const int n)
 	return model;
 }
 
-static void file_readline(FILE *f, char *line, const int n)
+/* Bytes read at once from an MPS stream */
+#define __lp_simplex_MPS_CHUNK__	(1 << 16)
+
+/* Lines of an MPS stream, read by chunks of `__lp_simplex_MPS_CHUNK__` bytes
+ */
+struct mps_Reader {
+	FILE *f;
+	char *buf;
+	size_t len;		/* bytes in `buf` */
+	size_t pos;		/* start of the next line in `buf` */
+};
+
+/* Copy the next line of `rd` into `line` (cut to n - 1 characters, without
+ * end of line, padded with '\0')
+ *
+ * Return 0 at the end of the stream
+ */
+static int mps_readline(struct mps_Reader *rd, char *line, const size_t n)
 {
-	lp_simplex_memset(line, '\0', n);
-	fgets(line, n, f);
-	line[lp_simplex_strcspn(line, "\r\n")] = '\0';
+	size_t k = 0, len;
+	char *start, *end;
+	int more = 0;
+
+	while (1) {
+		if (rd->pos == rd->len) {
+			rd->len = fread(rd->buf, 1, __lp_simplex_MPS_CHUNK__, rd->f);
+			rd->pos = 0;
+			if (rd->len == 0)
+				break;
+		}
+		more = 1;
+		start = rd->buf + rd->pos;
+		end = (char *)memchr(start, '\n', rd->len - rd->pos);
+		len = end ? (size_t)(end - start) : rd->len - rd->pos;
+		if (k < n - 1) {
+			lp_simplex_memcpy(line + k, start, __lp_simplex_MIN__(len, n - 1 - k));
+			k += __lp_simplex_MIN__(len, n - 1 - k);
+		}
+		rd->pos += len;
+		if (end) {
+			rd->pos++;
+			break;
+		}
+	}
+	line[k] = '\0';
+	k = lp_simplex_strcspn(line, "\r");
+	lp_simplex_memset(line + k, '\0', n - k);
+	return more;
 }
 
 static int change_sect_code(const char *line, int *sect_code)
@@ -336,53 +571,12 @@ static int change_sect_code(const char *line, int *sect_code)
 		return 1;
 }
 
-static int get_mps_info(const char *file, int *nrow, int *nvar)
-{
-	char line[128];
-	char last_var[8];
-	int sect_code = 0;
-
-	FILE *f = fopen(file, "r");
-
-	if (f == NULL) {
-		printf("Cannot open file: \"%s\"\n", file);
-		return lp_simplex_EXIT_FAILURE;
-	}
-	*nrow = 0;
-	*nvar = 0;
-	lp_simplex_memset(last_var, '\0', 8);
-LOOP:
-	file_readline(f, line, 128);
-
-	if (change_sect_code(line, &sect_code))
-		goto LOOP;
-	switch (sect_code) {
-	case 1:
-		(*nrow)++;
-		break;
-	case 2:
-		if (lp_simplex_memcmp(last_var, line + 4, 8) != 0) {
-			(*nvar)++;
-			lp_simplex_memcpy(last_var, line + 4, 8);
-		}
-		break;
-	default:
-		break;
-	}
-	if (feof(f))
-		goto END;
-	goto LOOP;
-END:
-	fclose(f);
-	return lp_simplex_EXIT_SUCCESS;
-}
-
 static double get_filed_1_value(const char *line)
 {
 	char value_str[13];
 	double value;
 
-	lp_simplex_memset(value_str, '\0', 12);
+	lp_simplex_memset(value_str, '\0', 13);
 	lp_simplex_memcpy(value_str, line + 24, 12);
 	value = lp_simplex_atof(value_str);
 	return value;
@@ -393,149 +587,333 @@ static double get_field_2_value(const char *line)
 	char value_str[13];
 	double value;
 
-	lp_simplex_memset(value_str, '\0', 12);
+	lp_simplex_memset(value_str, '\0', 13);
 	lp_simplex_memcpy(value_str, line + 49, 12);
 	value = lp_simplex_atof(value_str);
 	return value;
 }
 
-static void fill_model_coef(struct lp_Model *model, const double value, const char *field_name, const int nvars)
+/* Length of an MPS name field (at most 8, ended by a blank or '\0')
+ */
+static int mps_name_len(const char *name)
 {
-	int i, m = model->m;
+	int k;
 
-	for (i = 0; i < m; i++) {
-		char *tmp = model->constraints[i].name;
+	for (k = 0; k < 8 && name[k] != '\0' && name[k] != ' '; k++)
+		;
+	return k;
+}
 
-		if (lp_simplex_memcmp(field_name, tmp, lp_simplex_strlen(tmp)) == 0) {
-			model->constraints[i].coef[nvars - 1] = value;
-			break;
-		}
-	}
+static int mps_name_eq(const char *field, const char *name)
+{
+	int len = mps_name_len(name);
+
+	return len == mps_name_len(field) && lp_simplex_memcmp(field, name, len) == 0;
 }
 
-static void fill_columns_to_model(struct lp_Model *model, const char *obj_name, const char *field_name,
-				  const double value, const int nvars)
+/* Copy an MPS name field (blanks dropped)
+ */
+static void mps_name_copy(char *dest, const char *field)
 {
-	if (lp_simplex_memcmp(field_name, obj_name, lp_simplex_strlen(obj_name)) == 0)
-		model->objective[nvars - 1] = value;
-	else
-		fill_model_coef(model, value, field_name, nvars);
+	lp_simplex_memset(dest, '\0', 8);
+	lp_simplex_memcpy(dest, field, mps_name_len(field));
 }
 
-static void fill_model_rhs(struct lp_Model *model, const char *field_name, const double value)
+/* Least number of slots of a name index */
+#define __lp_simplex_MPS_INDEX_CAP__	64
+
+/* Open addressing hash table of MPS names (linear probing, at most half
+ * full), each with its row or column number
+ */
+struct mps_NameSlot {
+	char name[8];
+	int k;			/* -1 if the slot is empty */
+};
+
+struct mps_Index {
+	struct mps_NameSlot *slots;
+	int cap;		/* power of 2 */
+	int size;
+};
+
+/* FNV-1a hash of an MPS name field */
+static unsigned long mps_name_hash(const char *field)
 {
-	int i, m = model->m;
+	unsigned long h = 2166136261UL;
+	int k, len = mps_name_len(field);
 
-	for (i = 0; i < m; i++) {
-		char *tmp = model->constraints[i].name;
+	for (k = 0; k < len; k++)
+		h = ((h ^ (unsigned char)field[k]) * 16777619UL) & 0xffffffffUL;
+	return h;
+}
 
-		if (lp_simplex_memcmp(field_name, tmp, lp_simplex_strlen(tmp)) == 0) {
-			model->constraints[i].rhs = value;
-			break;
+static int mps_index_alloc(struct mps_Index *idx, const int cap)
+{
+	int s;
+
+	idx->slots = (struct mps_NameSlot *)lp_simplex_malloc(cap * sizeof(struct mps_NameSlot));
+	if (idx->slots == NULL)
+		return lp_simplex_EXIT_FAILURE;
+	for (s = 0; s < cap; s++)
+		idx->slots[s].k = -1;
+	idx->cap = cap;
+	idx->size = 0;
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+static void mps_index_free(struct mps_Index *idx)
+{
+	if (idx->slots)
+		lp_simplex_free(idx->slots);
+	idx->slots = NULL;
+}
+
+/* Slot of the name `field`, or the empty slot where it would go */
+static struct mps_NameSlot *mps_index_slot(const struct mps_Index *idx, const char *field)
+{
+	unsigned long s = mps_name_hash(field) & (idx->cap - 1);
+
+	while (idx->slots[s].k >= 0 && !mps_name_eq(field, idx->slots[s].name))
+		s = (s + 1) & (idx->cap - 1);
+	return idx->slots + s;
+}
+
+/* Number of the name `field`, or -1 if it is not indexed */
+static int mps_index_find(const struct mps_Index *idx, const char *field)
+{
+	return mps_index_slot(idx, field)->k;
+}
+
+/* Index the name `field` as number k (a name indexed already keeps its
+ * first number)
+ */
+static int mps_index_add(struct mps_Index *idx, const char *field, const int k)
+{
+	struct mps_NameSlot *slot, *old = idx->slots;
+	int s, cap = idx->cap;
+
+	if (2 * (idx->size + 1) > cap) {  /* rehash into twice the slots */
+		if (mps_index_alloc(idx, 2 * cap) == lp_simplex_EXIT_FAILURE) {
+			idx->slots = old;
+			return lp_simplex_EXIT_FAILURE;
+		}
+		for (s = 0; s < cap; s++) {
+			if (old[s].k < 0)
+				continue;
+			*mps_index_slot(idx, old[s].name) = old[s];
+			idx->size++;
 		}
+		lp_simplex_free(old);
 	}
+	slot = mps_index_slot(idx, field);
+	if (slot->k < 0) {
+		mps_name_copy(slot->name, field);
+		slot->k = k;
+		idx->size++;
+	}
+	return lp_simplex_EXIT_SUCCESS;
 }
 
-static int fill_model(const char *file, struct lp_Model *model)
+static int fill_columns_to_model(struct lp_SparseModel *model, const struct mps_Index *rows, const char *obj_name,
+				 const int j, const char *field_name, const double value)
+{
+	int i;
+
+	if (mps_name_eq(field_name, obj_name)) {
+		model->objective[j] = value;
+		return lp_simplex_EXIT_SUCCESS;
+	}
+	i = mps_index_find(rows, field_name);
+	if (i < 0 || value == 0.)
+		return lp_simplex_EXIT_SUCCESS;
+	return lp_simplex_sparse_add_coef(model, i, j, value);
+}
+
+static void fill_model_rhs(struct lp_SparseModel *model, const struct mps_Index *rows, const char *field_name,
+			   const double value)
+{
+	int i = mps_index_find(rows, field_name);
+
+	if (i >= 0)
+		model->constraints[i].rhs = value;
+}
+
+/* Read the sections of an MPS stream into `model`, indexing the names of
+ * its rows and columns in `rows` and `cols`
+ */
+static int fill_model(struct mps_Reader *rd, struct lp_SparseModel *model, struct mps_Index *rows,
+		      struct mps_Index *cols)
 {
 	char line[128];
+	char name[9];
 	char obj_name[9];
-	char *last_name = model->bounds->name;
-	int sect_code = 0;
-	int ncons = 0, nvars = 0;
+	char last_name[9];
+	int i, j = -1, type, sect_code = 0;
 	double value;
 
-	FILE *f = fopen(file, "r");
-
-	if (f == NULL) {
-		printf("Cannot open file: \"%s\"\n", file);
-		return lp_simplex_EXIT_FAILURE;
-	}
 	lp_simplex_memset(line, '\0', 128);
+	lp_simplex_memset(name, '\0', 9);
 	lp_simplex_memset(obj_name, '\0', 9);
-	lp_simplex_memset(last_name, '\0', 16);
-LOOP:
-	file_readline(f, line, 128);
-
-	if (change_sect_code(line, &sect_code))
-		goto LOOP;
-	switch (sect_code) {
-	case 1:  /* ROWS */
-		switch (line[1]) {
-		case 'N':
-			lp_simplex_memset(obj_name, '\0', 8);
-			lp_simplex_memcpy(obj_name, line + 4, 8);
-			break;
-		case 'L':
-			lp_simplex_memcpy(model->constraints[ncons].name, line + 4, 8);
-			model->constraints[ncons].type = optm_CONS_T_LE;
-			ncons++;
+	lp_simplex_memset(last_name, '\0', 9);
+	while (mps_readline(rd, line, 128)) {
+		if (change_sect_code(line, &sect_code))
+			continue;
+		switch (sect_code) {
+		case 1:  /* ROWS */
+			mps_name_copy(name, line + 4);
+			switch (line[1]) {
+			case 'N':
+				mps_name_copy(obj_name, line + 4);
+				continue;
+			case 'L':
+				type = optm_CONS_T_LE;
+				break;
+			case 'G':
+				type = optm_CONS_T_GE;
+				break;
+			case 'E':
+				type = optm_CONS_T_EQ;
+				break;
+			default:
+				continue;
+			}
+			i = lp_simplex_sparse_add_row(model, name, type, 0., 0, NULL, NULL);
+			if (i < 0 || mps_index_add(rows, name, i) == lp_simplex_EXIT_FAILURE)
+				return lp_simplex_EXIT_FAILURE;
 			break;
-		case 'G':
-			lp_simplex_memcpy(model->constraints[ncons].name, line + 4, 8);
-			model->constraints[ncons].type = optm_CONS_T_GE;
-			ncons++;
+		case 2:  /* COLUMNS */
+			if (lp_simplex_strlen(line) < 5)
+				break;
+			if (j < 0 || !mps_name_eq(line + 4, last_name)) {  /* a new column, or one seen before */
+				mps_name_copy(last_name, line + 4);
+				j = mps_index_find(cols, last_name);
+			}
+			if (j < 0) {
+				j = lp_simplex_sparse_add_col(model, last_name, 0., optm_BOUND_T_LO, 0.,
+							      __lp_simplex_INF__, 0, NULL, NULL);
+				if (j < 0 || mps_index_add(cols, last_name, j) == lp_simplex_EXIT_FAILURE)
+					return lp_simplex_EXIT_FAILURE;
+			}
+			value = get_filed_1_value(line);
+			if (fill_columns_to_model(model, rows, obj_name, j, line + 14, value) == lp_simplex_EXIT_FAILURE)
+				return lp_simplex_EXIT_FAILURE;
+			if (lp_simplex_strlen(line) < 40)
+				break;
+			value = get_field_2_value(line);
+			if (fill_columns_to_model(model, rows, obj_name, j, line + 39, value) == lp_simplex_EXIT_FAILURE)
+				return lp_simplex_EXIT_FAILURE;
 			break;
-		case 'E':
-			lp_simplex_memcpy(model->constraints[ncons].name, line + 4, 8);
-			model->constraints[ncons].type = optm_CONS_T_EQ;
-			ncons++;
+		case 3:  /* RHS */
+			value = get_filed_1_value(line);
+			fill_model_rhs(model, rows, line + 14, value);
+			if (lp_simplex_strlen(line) < 40)
+				break;
+			value = get_field_2_value(line);
+			fill_model_rhs(model, rows, line + 39, value);
 			break;
 		default:
 			break;
 		}
-		break;
-	case 2:  /* COLUMNS */
-		if (lp_simplex_memcmp(last_name, line + 4, 8) != 0) {
-			lp_simplex_memset(model->bounds[nvars].name, '\0', 16);
-			lp_simplex_memcpy(model->bounds[nvars].name, line + 4, 8);
-			last_name = model->bounds[nvars].name;
-			nvars++;
-		}
-		value = get_filed_1_value(line);
-		fill_columns_to_model(model, obj_name, line + 14, value, nvars);
-		if (lp_simplex_strlen(line) < 40)
-			goto LOOP;
-		value = get_field_2_value(line);
-		fill_columns_to_model(model, obj_name, line + 39, value, nvars);
-		break;
-	case 3:  /* RHS */
-		value = get_filed_1_value(line);
-		fill_model_rhs(model, line + 14, value);
-		if (lp_simplex_strlen(line) < 40)
-			goto LOOP;
-		value = get_field_2_value(line);
-		fill_model_rhs(model, line + 39, value);
-		break;
-	default:
-		break;
-	}
-	if (feof(f))
-		goto END;
-	goto LOOP;
-END:
+	}
+	return ferror(rd->f) ? lp_simplex_EXIT_FAILURE : lp_simplex_EXIT_SUCCESS;
+}
+
+struct lp_SparseModel *lp_simplex_read_mps_sparse_stream(FILE *f)
+{
+	struct lp_SparseModel *model;
+	struct mps_Reader rd;
+	struct mps_Index rows, cols;
+	int state = lp_simplex_EXIT_FAILURE;
+
+	assert(f != NULL);
+
+	rd.f = f;
+	rd.len = 0;
+	rd.pos = 0;
+	rd.buf = (char *)lp_simplex_malloc(__lp_simplex_MPS_CHUNK__);
+	model = lp_simplex_sparse_create();
+	rows.slots = NULL;
+	cols.slots = NULL;
+	if (rd.buf != NULL && model != NULL
+	    && mps_index_alloc(&rows, __lp_simplex_MPS_INDEX_CAP__) == lp_simplex_EXIT_SUCCESS
+	    && mps_index_alloc(&cols, __lp_simplex_MPS_INDEX_CAP__) == lp_simplex_EXIT_SUCCESS)
+		state = fill_model(&rd, model, &rows, &cols);
+	mps_index_free(&rows);
+	mps_index_free(&cols);
+	if (rd.buf)
+		lp_simplex_free(rd.buf);
+	if (state == lp_simplex_EXIT_FAILURE || lp_simplex_sparse_compress(model) == lp_simplex_EXIT_FAILURE) {
+		lp_simplex_sparse_free(model);
+		return NULL;
+	}
+	return model;
+}
+
+struct lp_SparseModel *lp_simplex_read_mps_sparse(const char *file)
+{
+	struct lp_SparseModel *model;
+	FILE *f = fopen(file, "r");
+
+	if (f == NULL) {
+		printf("Cannot open file: \"%s\"\n", file);
+		return NULL;
+	}
+	model = lp_simplex_read_mps_sparse_stream(f);
 	fclose(f);
-	return lp_simplex_EXIT_SUCCESS;
+	return model;
 }
 
-struct lp_Model *lp_simplex_read_mps(const char *file)
+struct lp_Model *lp_simplex_sparse_to_dense(struct lp_SparseModel *model)
 {
-	struct lp_Model *model;
-	int m, n;  /* number of constraints and variables */
-	int n_sect_row = 0, n_sect_columns = 0;
+	struct lp_Model *dense;
+	int i, j, k, m, n;
+
+	assert(model != NULL);
 
-	if (get_mps_info(file, &n_sect_row, &n_sect_columns) == lp_simplex_EXIT_FAILURE)
+	if (lp_simplex_sparse_compress(model) == lp_simplex_EXIT_FAILURE)
 		return NULL;
-	m = n_sect_row - 1;  /* the objective is also counted */
-	n = n_sect_columns;
-	model = create_model(m, n);
+	m = model->m;
+	n = model->n;
+	dense = create_model(m, n);
+	if (dense == NULL)
+		return NULL;
+	lp_simplex_memcpy(dense->objective, model->objective, n * sizeof(double));
+	lp_simplex_memcpy(dense->bounds, model->bounds, n * sizeof(struct optm_VariableBound));
+	for (i = 0; i < m; i++) {
+		lp_simplex_memcpy(dense->constraints[i].name, model->constraints[i].name, 8);
+		dense->constraints[i].rhs = model->constraints[i].rhs;
+		dense->constraints[i].type = model->constraints[i].type;
+		for (k = model->rowbeg[i]; k < model->rowbeg[i + 1]; k++) {
+			j = model->colidx[k];
+			dense->constraints[i].coef[j] = model->rowval[k];
+		}
+	}
+	return dense;
+}
 
-	if (model == NULL)
+/* Dense copy of the sparse model `sparse` (released)
+ */
+static struct lp_Model *sparse_to_dense_free(struct lp_SparseModel *sparse)
+{
+	struct lp_Model *model;
+
+	if (sparse == NULL)
 		return NULL;
-	fill_model(file, model);
+	model = lp_simplex_sparse_to_dense(sparse);
+	lp_simplex_sparse_free(sparse);
 	return model;
 }
 
+struct lp_Model *lp_simplex_read_mps(const char *file)
+{
+	return sparse_to_dense_free(lp_simplex_read_mps_sparse(file));
+}
+
+struct lp_Model *lp_simplex_read_mps_stream(FILE *f)
+{
+	return sparse_to_dense_free(lp_simplex_read_mps_sparse_stream(f));
+}
+
 void lp_simplex_model_free(struct lp_Model *model)
 {
 	if (model == NULL)
@@ -550,3 +928,137 @@ void lp_simplex_model_free(struct lp_Model *model)
 		lp_simplex_free(model->objective);
 	lp_simplex_free(model);
 }
+
+/* Name of row or column k in a basis file: `name`, or `prefix` and k + 1 if empty
+ */
+static void basis_name(char *dest, const char *name, const char prefix, const int k)
+{
+	lp_simplex_memset(dest, '\0', 9);
+	if (name != NULL && mps_name_len(name) > 0)
+		mps_name_copy(dest, name);
+	else
+		sprintf(dest, "%c%d", prefix, k + 1);
+}
+
+/* Index of the basis file names of the `len` rows of `constraints` (if not
+ * `NULL`), or of the `len` columns of `bounds`
+ */
+static int basis_index(struct mps_Index *idx, const struct optm_VariableBound *bounds,
+			const struct optm_LinearConstraint *constraints, const int len)
+{
+	char name[9];
+	int k;
+
+	if (mps_index_alloc(idx, __lp_simplex_MPS_INDEX_CAP__) == lp_simplex_EXIT_FAILURE)
+		return lp_simplex_EXIT_FAILURE;
+	for (k = 0; k < len; k++) {
+		if (constraints)
+			basis_name(name, constraints[k].name, 'R', k);
+		else
+			basis_name(name, bounds ? bounds[k].name : NULL, 'C', k);
+		if (mps_index_add(idx, name, k) == lp_simplex_EXIT_FAILURE)
+			return lp_simplex_EXIT_FAILURE;
+	}
+	return lp_simplex_EXIT_SUCCESS;
+}
+
+int lp_simplex_write_basis(const char *file, const struct optm_LinearConstraint *constraints,
+			const struct optm_VariableBound *bounds, const int m, const int n,
+			const int *cstat, const int *rstat)
+{
+	char name1[9], name2[9];
+	int i = 0, j;
+	FILE *f;
+
+	assert(constraints != NULL);
+	assert(cstat != NULL);
+	assert(rstat != NULL);
+
+	f = fopen(file, "w");
+	if (f == NULL) {
+		printf("Cannot open file: \"%s\"\n", file);
+		return lp_simplex_EXIT_FAILURE;
+	}
+	fprintf(f, "NAME\n");
+	for (j = 0; j < n; j++) {
+		basis_name(name1, bounds ? bounds[j].name : NULL, 'C', j);
+		if (cstat[j] == lp_simplex_BASIS_BASIC) {  /* paired with the next nonbasic row */
+			while (i < m && rstat[i] == lp_simplex_BASIS_BASIC)
+				i++;
+			if (i == m)
+				break;
+			basis_name(name2, constraints[i].name, 'R', i);
+			fprintf(f, " %s %-8s  %s\n", rstat[i] == lp_simplex_BASIS_UPPER ? "XU" : "XL", name1, name2);
+			i++;
+		} else if (cstat[j] == lp_simplex_BASIS_UPPER)
+			fprintf(f, " UL %s\n", name1);
+	}
+	while (j == n && i < m && rstat[i] == lp_simplex_BASIS_BASIC)
+		i++;
+	fprintf(f, "ENDATA\n");
+	fclose(f);
+	return j == n && i == m ? lp_simplex_EXIT_SUCCESS : lp_simplex_EXIT_FAILURE;  /* m basic variables */
+}
+
+int lp_simplex_read_basis(const char *file, const struct optm_LinearConstraint *constraints,
+			const struct optm_VariableBound *bounds, const int m, const int n,
+			int *cstat, int *rstat)
+{
+	char line[128];
+	int i, j, state = lp_simplex_EXIT_SUCCESS;
+	struct mps_Reader rd;
+	struct mps_Index rows, cols;
+
+	assert(constraints != NULL);
+	assert(cstat != NULL);
+	assert(rstat != NULL);
+
+	rd.f = fopen(file, "r");
+	if (rd.f == NULL) {
+		printf("Cannot open file: \"%s\"\n", file);
+		return lp_simplex_EXIT_FAILURE;
+	}
+	rd.len = 0;
+	rd.pos = 0;
+	rd.buf = (char *)lp_simplex_malloc(__lp_simplex_MPS_CHUNK__);
+	rows.slots = NULL;
+	cols.slots = NULL;
+	if (rd.buf == NULL || basis_index(&rows, NULL, constraints, m) == lp_simplex_EXIT_FAILURE
+	    || basis_index(&cols, bounds, NULL, n) == lp_simplex_EXIT_FAILURE)
+		state = lp_simplex_EXIT_FAILURE;
+	for (j = 0; j < n; j++)
+		cstat[j] = lp_simplex_BASIS_LOWER;
+	for (i = 0; i < m; i++)
+		rstat[i] = lp_simplex_BASIS_BASIC;
+	while (state == lp_simplex_EXIT_SUCCESS && mps_readline(&rd, line, 128)) {
+		if (lp_simplex_memcmp(line, "ENDATA", 6) == 0)
+			break;
+		if (line[0] != ' ' || lp_simplex_strlen(line) < 5)
+			continue;  /* NAME or blank line */
+		j = mps_index_find(&cols, line + 4);
+		if (j < 0) {
+			state = lp_simplex_EXIT_FAILURE;
+			break;
+		}
+		if (line[1] == 'X') {
+			i = lp_simplex_strlen(line) < 15 ? -1 : mps_index_find(&rows, line + 14);
+			if (i < 0 || (line[2] != 'U' && line[2] != 'L')) {
+				state = lp_simplex_EXIT_FAILURE;
+				break;
+			}
+			cstat[j] = lp_simplex_BASIS_BASIC;
+			rstat[i] = line[2] == 'U' ? lp_simplex_BASIS_UPPER : lp_simplex_BASIS_LOWER;
+		} else if (line[1] == 'U' && line[2] == 'L')
+			cstat[j] = lp_simplex_BASIS_UPPER;
+		else if (line[1] == 'L' && line[2] == 'L')
+			cstat[j] = lp_simplex_BASIS_LOWER;
+		else
+			state = lp_simplex_EXIT_FAILURE;
+	}
+	mps_index_free(&rows);
+	mps_index_free(&cols);
+	if (rd.buf)
+		lp_simplex_free(rd.buf);
+	fclose(rd.f);
+	return state;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex_utils.h>
+#include <lp_simplex/lp_simplex.h>
+
+/* Every buffer of a solve has its own slot (see `__lp_simplex_WS_*__`), which
+ * only grows: a solve no larger than the largest one so far allocates nothing.
+ * The pool is kept while solves ask for the same number of threads.
+ */
+struct lp_simplex_Workspace {
+	void *buf[__lp_simplex_WS_NSLOT__];
+	size_t cap[__lp_simplex_WS_NSLOT__];
+	struct lp_simplex_Pool *pool;
+	int nthreads;
+};
+
+struct lp_simplex_Workspace *lp_simplex_workspace_create(void)
+{
+	struct lp_simplex_Workspace *ws;
+
+	ws = (struct lp_simplex_Workspace *)lp_simplex_malloc(sizeof(struct lp_simplex_Workspace));
+	if (ws == NULL)
+		return NULL;
+	lp_simplex_memset(ws, 0, sizeof(struct lp_simplex_Workspace));
+	return ws;
+}
+
+void lp_simplex_workspace_free(struct lp_simplex_Workspace *ws)
+{
+	int k;
+
+	if (ws == NULL)
+		return;
+	for (k = 0; k < __lp_simplex_WS_NSLOT__; k++) {
+		lp_simplex_free_aligned(ws->buf[k]);
+	}
+	lp_simplex_pool_free(ws->pool);
+	lp_simplex_free(ws);
+}
+
+size_t lp_simplex_workspace_size(const struct lp_simplex_Workspace *ws)
+{
+	size_t size = 0;
+	int k;
+
+	for (k = 0; k < __lp_simplex_WS_NSLOT__; k++)
+		size += ws->cap[k];
+	return size;
+}
+
+void *lp_simplex_ws_alloc(struct lp_simplex_Workspace *ws, const int slot, size_t size)
+{
+	void *buf;
+
+	if (ws == NULL)
+		return lp_simplex_malloc_aligned(size, __lp_simplex_ALIGN__);
+	assert(0 <= slot && slot < __lp_simplex_WS_NSLOT__);
+	if (size == 0)
+		size = 1;
+	if (size <= ws->cap[slot])
+		return ws->buf[slot];
+	/* the old content is dropped, so there is nothing to copy */
+	buf = lp_simplex_malloc_aligned(size, __lp_simplex_ALIGN__);
+	if (buf == NULL)
+		return NULL;
+	lp_simplex_free_aligned(ws->buf[slot]);
+	ws->buf[slot] = buf;
+	ws->cap[slot] = size;
+	return buf;
+}
+
+void lp_simplex_ws_free(struct lp_simplex_Workspace *ws, void *ptr)
+{
+	if (ws == NULL)
+		lp_simplex_free_aligned(ptr);
+}
+
+struct lp_simplex_Pool *lp_simplex_ws_pool(struct lp_simplex_Workspace *ws, const int nthreads)
+{
+	if (ws == NULL)
+		return lp_simplex_pool_create(nthreads);
+	if (ws->pool == NULL || ws->nthreads != nthreads) {
+		lp_simplex_pool_free(ws->pool);
+		ws->pool = lp_simplex_pool_create(nthreads);
+		ws->nthreads = nthreads;
+	}
+	return ws->pool;
+}
+
+void lp_simplex_ws_pool_release(struct lp_simplex_Workspace *ws, struct lp_simplex_Pool *pool)
+{
+	if (ws == NULL)
+		lp_simplex_pool_free(pool);
+}
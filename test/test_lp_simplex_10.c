@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: re-optimization by the dual simplex algorithm
+ *
+ *         min    2 * x1 + 3 * x2 +     x3
+ *         s.t.       x1 +     x2 +     x3 >= 4
+ *                    x1 -     x2          =  1
+ *                             x2 + 2 * x3 <= 6
+ *                x1, x2, x3 >= 0
+ *
+ * The solution is (1, 0, 3) and the optimal value is 5.
+ *
+ * 1. the first rhs changes to 5: the solution is (5/3, 2/3, 8/3) and the
+ *    optimal value is 8
+ * 2. the bound of x3 changes to [0, 2]: the solution is (2, 1, 2) and the
+ *    optimal value is 9
+ */
+#define m 3        /* number of constraints */
+#define n 3        /* number of variables   */
+
+double obj[] = {2., 3., 1.};
+double constraint_1_coef[] = {1.,  1., 1.};
+double constraint_2_coef[] = {1., -1., 0.};
+double constraint_3_coef[] = {0.,  1., 2.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 4., optm_CONS_T_GE },
+	{ "", constraint_2_coef, 1., optm_CONS_T_EQ },
+	{ "", constraint_3_coef, 6., optm_CONS_T_LE }
+};
+
+int main(void)
+{
+	double x[n], value;
+	int code, state;
+	struct lp_simplex_Solver *solver = lp_simplex_solver_create(obj, constraints, NULL, m, n);
+
+	assert(solver != NULL);
+	state = lp_simplex_solver_solve(solver, 1000, x, &value, &code);
+	printf("Error code = %u\n", code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value - 5.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[0] - 1.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[1]) < 1e-8);
+	assert(__lp_simplex_ABS__(x[2] - 3.) < 1e-8);
+
+	lp_simplex_solver_set_rhs(solver, 0, 5.);
+	state = lp_simplex_solver_solve(solver, 1000, x, &value, &code);
+	printf("Error code = %u\n", code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value - 8.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[0] - 5. / 3) < 1e-8);
+	assert(__lp_simplex_ABS__(x[1] - 2. / 3) < 1e-8);
+	assert(__lp_simplex_ABS__(x[2] - 8. / 3) < 1e-8);
+
+	lp_simplex_solver_set_bounds(solver, 2, 0., 2.);
+	state = lp_simplex_solver_solve(solver, 1000, x, &value, &code);
+	printf("Error code = %u\n", code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value - 9.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[0] - 2.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[1] - 1.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[2] - 2.) < 1e-8);
+
+	lp_simplex_solver_free(solver);
+	return 0;
+}
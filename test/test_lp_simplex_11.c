@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: bounded variables handled without upper-bound rows
+ *
+ *         min    - x1 - 2 * x2 - 4 * x3
+ *         s.t.     x1 +     x2 +     x3 <=  5
+ *                  x1              - x3 >= -1
+ *                0 <= x1 <= 2
+ *                1 <= x2 <= 3
+ *                0 <= x3 <= 2.5
+ *
+ * The solution is (1.5, 1, 2.5) and the optimal value is -13.5
+ */
+#define m 2        /* number of constraints */
+#define n 3        /* number of variables   */
+
+double obj[] = {-1., -2., -4.};
+double constraint_1_coef[] = {1., 1.,  1.};
+double constraint_2_coef[] = {1., 0., -1.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef,  5., optm_CONS_T_LE },
+	{ "", constraint_2_coef, -1., optm_CONS_T_GE }
+};
+
+struct optm_VariableBound bounds[] = {
+	{ "x1", 0., 2.,  optm_BOUND_T_UP, optm_VAR_T_REAL },
+	{ "x2", 1., 3.,  optm_BOUND_T_BS, optm_VAR_T_REAL },
+	{ "x3", 0., 2.5, optm_BOUND_T_BS, optm_VAR_T_REAL }
+};
+
+static void solve(const char *criteria)
+{
+	double x[n], value;
+	int code;
+	int state = lp_simplex(obj, constraints, bounds, m, n, criteria, 1000, x, &value, &code);
+
+	printf("%s: error code = %u\n", criteria, code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value + 13.5) < 1e-8);
+	assert(__lp_simplex_ABS__(x[0] - 1.5) < 1e-8);
+	assert(__lp_simplex_ABS__(x[1] - 1.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[2] - 2.5) < 1e-8);
+}
+
+int main(void)
+{
+	solve("");
+	solve("dantzig");
+	solve("bland");
+	solve("steepest");
+	solve("revised");
+	return 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: free variables handled without splitting columns
+ *
+ *         min        x1 +     x2
+ *         s.t.       x1 -     x2 >= -2
+ *                2 * x1 +     x2 >= -1
+ *                    x1 + 3 * x2 >=  0
+ *                x1, x2 free
+ *
+ * The solution is (-0.6, 0.2) and the optimal value is -0.4
+ */
+#define m 3        /* number of constraints */
+#define n 2        /* number of variables   */
+
+double obj[] = {1., 1.};
+double constraint_1_coef[] = {1., -1.};
+double constraint_2_coef[] = {2.,  1.};
+double constraint_3_coef[] = {1.,  3.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, -2., optm_CONS_T_GE },
+	{ "", constraint_2_coef, -1., optm_CONS_T_GE },
+	{ "", constraint_3_coef,  0., optm_CONS_T_GE }
+};
+
+struct optm_VariableBound bounds[] = {
+	{ "x1", __lp_simplex_NINF__, __lp_simplex_INF__, optm_BOUND_T_FR, optm_VAR_T_REAL },
+	{ "x2", __lp_simplex_NINF__, __lp_simplex_INF__, optm_BOUND_T_FR, optm_VAR_T_REAL }
+};
+
+static void solve(const char *criteria)
+{
+	double x[n], value;
+	int code;
+	int state = lp_simplex(obj, constraints, bounds, m, n, criteria, 1000, x, &value, &code);
+
+	printf("%s: error code = %u\n", criteria, code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value + 0.4) < 1e-8);
+	assert(__lp_simplex_ABS__(x[0] + 0.6) < 1e-8);
+	assert(__lp_simplex_ABS__(x[1] - 0.2) < 1e-8);
+}
+
+int main(void)
+{
+	solve("");
+	solve("dantzig");
+	solve("bland");
+	solve("devex");
+	solve("revised");
+	return 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: dual ratio test passing a breakpoint by a bound flip
+ *
+ *         min    - 3 * x1 - 2 * x2 - x3
+ *         s.t.       x1 +     x2 + x3 <= 10
+ *                0 <= x1, x2, x3 <= 1
+ *
+ * The solution is (1, 1, 1) and the optimal value is -6.
+ *
+ * When the rhs changes to 1.5, x3 flips to 0 and x2 enters the basis in the
+ * same dual iteration: the solution is (1, 0.5, 0) and the optimal value is -4.
+ */
+#define m 1        /* number of constraints */
+#define n 3        /* number of variables   */
+
+double obj[] = {-3., -2., -1.};
+double constraint_1_coef[] = {1., 1., 1.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 10., optm_CONS_T_LE }
+};
+
+struct optm_VariableBound bounds[] = {
+	{ "x1", 0., 1., optm_BOUND_T_BS, optm_VAR_T_REAL },
+	{ "x2", 0., 1., optm_BOUND_T_BS, optm_VAR_T_REAL },
+	{ "x3", 0., 1., optm_BOUND_T_BS, optm_VAR_T_REAL }
+};
+
+int main(void)
+{
+	double x[n], value;
+	int code, state;
+	struct lp_simplex_Solver *solver = lp_simplex_solver_create(obj, constraints, bounds, m, n);
+
+	assert(solver != NULL);
+	state = lp_simplex_solver_solve(solver, 1000, x, &value, &code);
+	printf("Error code = %u\n", code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value + 6.) < 1e-8);
+
+	lp_simplex_solver_set_rhs(solver, 0, 1.5);
+	state = lp_simplex_solver_solve(solver, 1000, x, &value, &code);
+	printf("Error code = %u\n", code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value + 4.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[0] - 1.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[1] - 0.5) < 1e-8);
+	assert(__lp_simplex_ABS__(x[2]) < 1e-8);
+
+	lp_simplex_solver_free(solver);
+	return 0;
+}
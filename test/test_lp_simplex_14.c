@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+/* LP Example: row-parallel pivot
+ *
+ *         min    - sum_j c_j * x_j
+ *         s.t.   sum_j a_ij * x_j <= b_i,  i = 1, ..., m
+ *                x >= 0
+ *
+ * with dense deterministic coefficients, large enough for the pivots to be
+ * shared by the worker pool. The threaded solve must reproduce the serial
+ * solution bit for bit.
+ */
+#define m 120      /* number of constraints */
+#define n 160      /* number of variables   */
+
+double obj[n];
+double coef[m][n];
+struct optm_LinearConstraint constraints[m];
+
+static void build(void)
+{
+	int i, j;
+
+	for (j = 0; j < n; j++)
+		obj[j] = -(1. + (j * 37 % 23) / 8.);
+	for (i = 0; i < m; i++) {
+		for (j = 0; j < n; j++)
+			coef[i][j] = (i * 13 + j * 7) % 11 == 0 ? 0. : 0.5 + ((i * 29 + j * 17) % 19) / 6.;
+		constraints[i].coef = coef[i];
+		constraints[i].rhs = 50. + (i * 31 % 41);
+		constraints[i].type = optm_CONS_T_LE;
+	}
+}
+
+int main(void)
+{
+	const char *criteria[] = {"", "dantzig", "steepest", "devex"};
+	double x1[n], x4[n], value1, value4;
+	int k, code;
+	struct lp_simplex_Options serial, parallel;
+
+	build();
+	memset(&serial, 0, sizeof(serial));
+	memset(&parallel, 0, sizeof(parallel));
+	parallel.nthreads = 4;
+	for (k = 0; k < 4; k++) {
+		assert(lp_simplex_opt(obj, constraints, NULL, m, n, criteria[k], 10000, &serial,
+				      x1, &value1, &code) == lp_simplex_EXIT_SUCCESS);
+		assert(lp_simplex_opt(obj, constraints, NULL, m, n, criteria[k], 10000, &parallel,
+				      x4, &value4, &code) == lp_simplex_EXIT_SUCCESS);
+		printf("criteria = \"%s\", value = %f\n", criteria[k], value4);
+		assert(value1 == value4);
+		assert(memcmp(x1, x4, sizeof(x1)) == 0);
+	}
+	return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <assert.h>
+
+/* Pivot kernel: fused tableau update against the BLAS path
+ *
+ * A dense pseudo-random table is pivoted (column q, row of the largest |y|)
+ * by `lp_simplex_pivot_core` on every instruction set of the CPU and by the
+ * former per-row `dscal` + `daxpy` loop. All instruction sets must agree
+ * bit for bit, and with BLAS (also the "blas" fallback kernel) up to rounding.
+ */
+#define m 200      /* number of constraints */
+#define n 600      /* number of variables   */
+#define ld (n + 1)
+#define npivot 50
+
+double table0[(m + 1) * ld];	/* initial table */
+double tblas[(m + 1) * ld];	/* BLAS path */
+double tscal[(m + 1) * ld];	/* scalar kernel */
+double tsimd[(m + 1) * ld];	/* SIMD kernels */
+
+static void pivot_blas(double *table, const int p, const int q)
+{
+	int i, rowp = (p + 1) * ld;
+
+	lp_simplex_linalg_dscal(ld, 1 / table[q + rowp], table + rowp, 1);
+	for (i = 0; i < m; i++) {
+		if (i != p)
+			lp_simplex_linalg_daxpy(ld, -table[q + (i + 1) * ld], table + rowp, 1, table + (i + 1) * ld, 1);
+	}
+	lp_simplex_linalg_daxpy(ld, -table[q], table + rowp, 1, table, 1);
+}
+
+static double run(double *table, const int blas)
+{
+	int i, k;
+	clock_t t = clock();
+
+	memcpy(table, table0, sizeof(table0));
+	for (k = 0; k < npivot; k++) {
+		int p = 0, q = k * 7 % n;
+
+		for (i = 1; i < m; i++) {
+			if (__lp_simplex_ABS__(table[q + (i + 1) * ld]) > __lp_simplex_ABS__(table[q + (p + 1) * ld]))
+				p = i;
+		}
+		if (blas)
+			pivot_blas(table, p, q);
+		else
+			lp_simplex_pivot_core(table, ld, m, n, p, q, 1, 1, 1);
+	}
+	return (double)(clock() - t) / CLOCKS_PER_SEC;
+}
+
+int main(void)
+{
+	const char *isas[] = {"avx2", "avx512"};
+	const char *best = lp_simplex_kernel_isa();
+	int i, k;
+	unsigned long seed = 1;
+	double gap = 0.;
+
+	for (i = 0; i < (m + 1) * ld; i++) {
+		seed = (seed * 1103515245UL + 12345UL) % 2147483648UL;
+		table0[i] = (double)seed / 1073741824. - 1.;
+	}
+	printf("blas    %f s\n", run(tblas, 1));
+	assert(lp_simplex_kernel_use("scalar") == lp_simplex_EXIT_SUCCESS);
+	printf("scalar  %f s\n", run(tscal, 0));
+	for (i = 0; i < (m + 1) * ld; i++) {
+		double d = __lp_simplex_ABS__(tscal[i] - tblas[i]) / __lp_simplex_MAX__(1., __lp_simplex_ABS__(tblas[i]));
+
+		gap = __lp_simplex_MAX__(gap, d);
+	}
+	printf("relative gap to BLAS = %e\n", gap);
+	assert(gap < 1e-9);
+	if (lp_simplex_kernel_use("blas") == lp_simplex_EXIT_SUCCESS) {
+		printf("blas    %f s (kernel)\n", run(tsimd, 0));
+		for (gap = 0., i = 0; i < (m + 1) * ld; i++) {
+			double d = __lp_simplex_ABS__(tsimd[i] - tblas[i]) / __lp_simplex_MAX__(1., __lp_simplex_ABS__(tblas[i]));
+
+			gap = __lp_simplex_MAX__(gap, d);
+		}
+		assert(gap < 1e-9);
+	}
+	for (k = 0; k < 2; k++) {
+		if (lp_simplex_kernel_use(isas[k]) != lp_simplex_EXIT_SUCCESS)
+			continue;
+		printf("%-7s %f s\n", isas[k], run(tsimd, 0));
+		assert(memcmp(tsimd, tscal, sizeof(tscal)) == 0);
+	}
+	assert(lp_simplex_kernel_use(best) == lp_simplex_EXIT_SUCCESS);
+	return 0;
+}
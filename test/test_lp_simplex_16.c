@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* Pricing kernels: every instruction set of the CPU must return the same
+ * answers as the scalar loops, including ties (first index), NaN (skipped)
+ * and lengths that are not a multiple of the vector width; strided
+ * `daxpy` and `dscal` touch exactly n elements.
+ */
+#define len 37
+
+int main(void)
+{
+	const char *isas[] = {"scalar", "blas", "sse2", "avx2", "avx512"};
+	const char *best = lp_simplex_kernel_isa();
+	double x[len], y[len], nan = 0. / 0.;
+	int idx[len], i, k;
+
+	for (i = 0; i < len; i++) {
+		x[i] = (i * 17 % 13) - 6.;
+		y[i] = (i * 5 % 7) - 3.;
+		idx[i] = (i * 11) % len;
+	}
+	x[3] = nan;
+	x[30] = -9.;
+	x[34] = 9.;
+	x[35] = 9.;  /* ties */
+	for (k = 0; k < 5; k++) {
+		if (lp_simplex_kernel_use(isas[k]) != lp_simplex_EXIT_SUCCESS)
+			continue;
+		printf("%s\n", isas[k]);
+		assert(lp_simplex_kernel_any_above(x, 8.5, len) == 1);
+		assert(lp_simplex_kernel_any_above(x, 9., len) == 0);
+		assert(lp_simplex_kernel_any_above(x, 9., 0) == 0);
+		assert(lp_simplex_kernel_maxabs(x, len) == 9.);
+		assert(lp_simplex_kernel_maxabs(x, 30) == 6.);
+		assert(lp_simplex_kernel_argmaxabs(x, len) == 30);
+		assert(lp_simplex_kernel_maxabs_gap(x, y, len) == 12.);
+		assert(lp_simplex_kernel_argmax_at(x, idx, 0., len) == 20);  /* idx[20] = 35 comes before idx[30] = 34 */
+		assert(lp_simplex_kernel_argmax_at(x, idx, 9., len) == len);
+		assert(argmaxabs_arrd(x, len, 1) == 30);
+		assert(maxabs_arrd(x + 1, len - 1, 2) == 9.);
+	}
+	assert(lp_simplex_kernel_use(best) == lp_simplex_EXIT_SUCCESS);
+
+	for (i = 0; i < len; i++)
+		y[i] = 1.;
+	lp_simplex_linalg_daxpy(3, 2., x + 4, 2, y, 3);  /* y[0, 3, 6] += 2 * x[4, 6, 8] */
+	assert(y[0] == 1. + 2. * x[4] && y[3] == 1. + 2. * x[6] && y[6] == 1. + 2. * x[8]);
+	assert(y[1] == 1. && y[9] == 1.);
+	lp_simplex_linalg_dscal(3, 2., y + 1, 4);  /* y[1, 5, 9] *= 2 */
+	assert(y[1] == 2. && y[5] == 2. && y[9] == 2. && y[13] == 1.);
+	return 0;
+}
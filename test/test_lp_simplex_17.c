@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: sparse model from the builder and from an MPS file
+ *
+ *         max    3 * x + 4 * y
+ *         s.t.       x + 2 * y <= 14
+ *                3 * x -     y >=  0
+ *                    x -     y <=  2
+ *                x, y >= 0
+ *
+ * The solution is (6., 4.) and the optimal value is 34
+ */
+#define file "test_lp_simplex_17.mps"
+
+static void check(struct lp_SparseModel *model, const char *criteria)
+{
+	double x[2], value;
+	int code, k, state;
+	struct lp_simplex_Options opts = {0};
+
+	for (k = 0; k < 3; k++) {  /* default options, presolve, scaling */
+		opts.presolve = k == 1;
+		opts.scaling = k == 2;
+		state = lp_simplex_sparse(model, criteria, 1000, k ? &opts : NULL, x, &value, &code);
+		printf("criteria = \"%s\" (presolve = %d, scaling = %d), error code = %u\n",
+		       criteria, opts.presolve, opts.scaling, code);
+		assert(state == lp_simplex_EXIT_SUCCESS);
+		assert(__lp_simplex_ABS__(value + 34.) < 1e-8);
+		assert(__lp_simplex_ABS__(x[0] - 6.) < 1e-8);
+		assert(__lp_simplex_ABS__(x[1] - 4.) < 1e-8);
+	}
+}
+
+static void write_mps(void)
+{
+	FILE *f = fopen(file, "w");
+
+	assert(f != NULL);
+	fprintf(f, "NAME          EXAMPLE\n");
+	fprintf(f, "ROWS\n");
+	fprintf(f, " N  COST\n");
+	fprintf(f, " L  LIM1\n");
+	fprintf(f, " G  LIM2\n");
+	fprintf(f, " L  LIM3\n");
+	fprintf(f, "COLUMNS\n");
+	fprintf(f, "    %-8s  %-8s  %-12s   %-8s  %-12s\n", "X", "COST", "-3.", "LIM1", "1.");
+	fprintf(f, "    %-8s  %-8s  %-12s   %-8s  %-12s\n", "X", "LIM2", "3.", "LIM3", "1.");
+	fprintf(f, "    %-8s  %-8s  %-12s   %-8s  %-12s\n", "Y", "COST", "-4.", "LIM1", "2.");
+	fprintf(f, "    %-8s  %-8s  %-12s   %-8s  %-12s\n", "Y", "LIM2", "-1.", "LIM3", "-1.");
+	fprintf(f, "RHS\n");
+	fprintf(f, "    %-8s  %-8s  %-12s   %-8s  %-12s\n", "RHS", "LIM1", "14.", "LIM3", "2.");
+	fprintf(f, "ENDATA\n");
+	fclose(f);
+}
+
+int main(void)
+{
+	int i, j;
+	int x_idx[] = {0, 1, 2}, y_idx[] = {0, 1, 2};
+	double x_val[] = {1., 3., 1.}, y_val[] = {1.5, -1., -1.};
+	double coef[3][2] = {{1., 2.}, {3., -1.}, {1., -1.}};
+	struct lp_SparseModel *model = lp_simplex_sparse_create();
+	struct lp_Model *dense;
+
+	/* rows first, then columns, and a coefficient split in two triplets */
+	assert(model != NULL);
+	assert(lp_simplex_sparse_add_row(model, "LIM1", optm_CONS_T_LE, 14., 0, NULL, NULL) == 0);
+	assert(lp_simplex_sparse_add_row(model, "LIM2", optm_CONS_T_GE, 0., 0, NULL, NULL) == 1);
+	assert(lp_simplex_sparse_add_row(model, "LIM3", optm_CONS_T_LE, 2., 0, NULL, NULL) == 2);
+	assert(lp_simplex_sparse_add_col(model, "X", -3., optm_BOUND_T_LO, 0., __lp_simplex_INF__,
+					 3, x_idx, x_val) == 0);
+	assert(lp_simplex_sparse_add_col(model, "Y", -4., optm_BOUND_T_LO, 0., __lp_simplex_INF__,
+					 3, y_idx, y_val) == 1);
+	assert(lp_simplex_sparse_add_coef(model, 0, 1, 0.5) == lp_simplex_EXIT_SUCCESS);
+	assert(lp_simplex_sparse_compress(model) == lp_simplex_EXIT_SUCCESS);
+	assert(model->nz == 6);
+	assert(model->colbeg[1] == 3 && model->rowidx[0] == 0 && model->colval[3] == 2.);
+	assert(model->rowbeg[1] == 2 && model->colidx[1] == 1 && model->rowval[1] == 2.);
+	check(model, "revised");
+	check(model, "");
+	check(model, "bland");
+	lp_simplex_sparse_free(model);
+
+	write_mps();
+	model = lp_simplex_read_mps_sparse(file);
+	assert(model != NULL);
+	assert(model->m == 3 && model->n == 2 && model->nz == 6);
+	check(model, "revised");
+	check(model, "dantzig");
+	lp_simplex_sparse_free(model);
+
+	dense = lp_simplex_read_mps(file);
+	assert(dense != NULL);
+	for (i = 0; i < 3; i++) {
+		for (j = 0; j < 2; j++)
+			assert(dense->constraints[i].coef[j] == coef[i][j]);
+	}
+	assert(dense->constraints[0].rhs == 14. && dense->constraints[1].type == optm_CONS_T_GE);
+	lp_simplex_model_free(dense);
+	remove(file);
+	return 0;
+}
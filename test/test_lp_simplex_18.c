@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* Size of the reduced LP (before the macros `m` and `n` below)
+ */
+static void reduced_size(const struct lp_simplex_Presolve *ps, int *rows, int *cols)
+{
+	const struct lp_Model *md = lp_simplex_presolve_model(ps);
+
+	*rows = md->m;
+	*cols = md->n;
+}
+
+/* LP Example: presolve and postsolve
+ *
+ *   min   x1 + 2 x2 - x3 + x4 + 3 x6 + x7 + x8
+ *   s.t.  x1 + x2 + x3 + x4       >=  2
+ *         2 x3                    <=  4	(singleton row)
+ *         x1 - x2                  =  0	(doubleton equation)
+ *         x4 + x5 + x8            <=  3	(x5: singleton column as slack)
+ *         0                       >= -1	(empty row)
+ *         x7 - x1                 >= -5	(x7: free singleton column)
+ *         x4 + x8                 <= 10	(x8: dominated column)
+ *         0 <= x3 <= 5, x6 = 1, x7 free, others >= 0
+ *
+ * The solution is (0, 0, 2, 0, x5, 1, -5, 0) with 0 <= x5 <= 3 and the
+ * optimal value is -4
+ */
+#define m 7        /* number of constraints */
+#define n 8        /* number of variables   */
+
+double obj[] = {1., 2., -1., 1., 0., 3., 1., 1.};
+double constraint_1_coef[] = { 1.,  1., 1., 1., 0., 0., 0., 0.};
+double constraint_2_coef[] = { 0.,  0., 2., 0., 0., 0., 0., 0.};
+double constraint_3_coef[] = { 1., -1., 0., 0., 0., 0., 0., 0.};
+double constraint_4_coef[] = { 0.,  0., 0., 1., 1., 0., 0., 1.};
+double constraint_5_coef[] = { 0.,  0., 0., 0., 0., 0., 0., 0.};
+double constraint_6_coef[] = {-1.,  0., 0., 0., 0., 0., 1., 0.};
+double constraint_7_coef[] = { 0.,  0., 0., 1., 0., 0., 0., 1.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef,  2., optm_CONS_T_GE },
+	{ "", constraint_2_coef,  4., optm_CONS_T_LE },
+	{ "", constraint_3_coef,  0., optm_CONS_T_EQ },
+	{ "", constraint_4_coef,  3., optm_CONS_T_LE },
+	{ "", constraint_5_coef, -1., optm_CONS_T_GE },
+	{ "", constraint_6_coef, -5., optm_CONS_T_GE },
+	{ "", constraint_7_coef, 10., optm_CONS_T_LE }
+};
+
+struct optm_VariableBound bounds[] = {
+	{ "x1", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL },
+	{ "x2", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL },
+	{ "x3", 0., 5., optm_BOUND_T_UP, optm_VAR_T_REAL },
+	{ "x4", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL },
+	{ "x5", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL },
+	{ "x6", 1., 1., optm_BOUND_T_BS, optm_VAR_T_REAL },
+	{ "x7", __lp_simplex_NINF__, __lp_simplex_INF__, optm_BOUND_T_FR, optm_VAR_T_REAL },
+	{ "x8", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL }
+};
+
+static void solve(const char *criteria, const int presolve)
+{
+	double x[n], value, sol[] = {0., 0., 2., 0., 0., 1., -5., 0.};
+	struct lp_simplex_Options opts = {0};
+	int j, code, state;
+
+	opts.presolve = presolve;
+	state = lp_simplex_opt(obj, constraints, bounds, m, n, criteria, 1000, &opts, x, &value, &code);
+	printf("%s (presolve = %d): error code = %u\n", criteria, presolve, code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value + 4.) < 1e-8);
+	for (j = 0; j < n; j++) {
+		if (j != 4)
+			assert(__lp_simplex_ABS__(x[j] - sol[j]) < 1e-8);
+	}
+	assert(x[4] >= -1e-8 && x[4] <= 3. + 1e-8);
+}
+
+/* x1 >= 3 and x1 <= 1 are decided by the presolve
+ */
+static void infeasible(void)
+{
+	static double c1[] = {1., 0.}, c2[] = {1., 0.}, c3[] = {1., 1.};
+	static struct optm_LinearConstraint cons[] = {
+		{ "", c1, 3., optm_CONS_T_GE },
+		{ "", c2, 1., optm_CONS_T_LE },
+		{ "", c3, 9., optm_CONS_T_LE }
+	};
+	double x[2], value;
+	struct lp_simplex_Options opts = {0};
+	struct lp_simplex_Presolve *ps;
+	int code;
+
+	ps = lp_simplex_presolve(obj, cons, NULL, 3, 2, &code);
+	assert(ps == NULL && code == lp_simplex_Infeasibility);
+	opts.presolve = 1;
+	assert(lp_simplex_opt(obj, cons, NULL, 3, 2, "", 1000, &opts, x, &value, &code) == lp_simplex_EXIT_FAILURE);
+	assert(code == lp_simplex_Infeasibility);
+}
+
+int main(void)
+{
+	struct lp_simplex_Presolve *ps;
+	int code, rows, cols;
+
+	ps = lp_simplex_presolve(obj, constraints, bounds, m, n, &code);
+	assert(ps != NULL && code == lp_simplex_Success);
+	reduced_size(ps, &rows, &cols);
+	printf("reduced: m = %d, n = %d\n", rows, cols);
+	assert(rows < m && cols < n);
+	lp_simplex_presolve_free(ps);
+
+	solve("", 0);
+	solve("", 1);
+	solve("dantzig", 1);
+	solve("steepest", 1);
+	solve("revised", 1);
+	infeasible();
+	return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: badly scaled LP solved with row and column scaling
+ *
+ *         min     -1e4 * y1 -  1e-3 * y2
+ *         s.t.         y1   +  2e-7 * y2 <= 4e-4
+ *                   3e9 * y1 +   100 * y2 <= 6e5
+ *                  y1, y2 >= 0
+ *
+ * which is (x1, x2) = (1e4 * y1, 1e-3 * y2) of
+ *
+ *         min     -x1 - x2
+ *         s.t.     x1 + 2 * x2 <= 4
+ *              3 * x1 +     x2 <= 6
+ *
+ * The solution is (1.6e-4, 1200) and the optimal value is -2.8
+ */
+#define m 2        /* number of constraints */
+#define n 2        /* number of variables   */
+
+double obj[] = {-1e4, -1e-3};
+double constraint_1_coef[] = {1., 2e-7};
+double constraint_2_coef[] = {3e9, 100.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 4e-4, optm_CONS_T_LE },
+	{ "", constraint_2_coef, 6e5,  optm_CONS_T_LE }
+};
+
+static void scale_factors(void)
+{
+	double rs[m], cs[n], e;
+	int i, j;
+
+	assert(lp_simplex_scale(constraints, m, n, rs, cs) == lp_simplex_EXIT_SUCCESS);
+	for (j = 0; j < n; j++) {
+		double maxv = 0.;
+
+		for (i = 0; i < m; i++) {
+			e = __lp_simplex_ABS__(constraints[i].coef[j] * rs[i] * cs[j]);
+			maxv = __lp_simplex_MAX__(maxv, e);
+			assert(e > 1e-3 && e < 2.);
+		}
+		assert(maxv >= 1.);
+	}
+}
+
+static void solve(const char *criteria)
+{
+	double x[n], value;
+	struct lp_simplex_Options opts = {0};
+	int code, state;
+
+	opts.scaling = 1;
+	state = lp_simplex_opt(obj, constraints, NULL, m, n, criteria, 1000, &opts, x, &value, &code);
+	printf("%s: error code = %u\n", criteria, code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value + 2.8) < 1e-8);
+	assert(__lp_simplex_ABS__(x[0] / 1.6e-4 - 1.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[1] / 1200. - 1.) < 1e-8);
+}
+
+int main(void)
+{
+	scale_factors();
+	solve("");
+	solve("dantzig");
+	solve("steepest");
+	solve("revised");
+	return 0;
+}
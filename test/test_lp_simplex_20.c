@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: phase 1 from a crash basis
+ *
+ *         min        x1 + x2 + x3 + x4
+ *         s.t.       x1 + x2           >= 2
+ *                         x2 + x3       = 3
+ *                              x3 + x4 >= 1
+ *                    x1           - x4 <= 4
+ *                x1, x2, x3, x4 >= 0
+ *
+ * The solution is (0, 2, 1, 0) and the optimal value is 3. With the bound
+ * x2 <= 1.5 the solution is (0.5, 1.5, 1.5, 0) and the optimal value is 3.5
+ */
+#define m 4        /* number of constraints */
+#define n 4        /* number of variables   */
+
+double obj[] = {1., 1., 1., 1.};
+double constraint_1_coef[] = {1., 1., 0.,  0.};
+double constraint_2_coef[] = {0., 1., 1.,  0.};
+double constraint_3_coef[] = {0., 0., 1.,  1.};
+double constraint_4_coef[] = {1., 0., 0., -1.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 2., optm_CONS_T_GE },
+	{ "", constraint_2_coef, 3., optm_CONS_T_EQ },
+	{ "", constraint_3_coef, 1., optm_CONS_T_GE },
+	{ "", constraint_4_coef, 4., optm_CONS_T_LE }
+};
+
+struct optm_VariableBound bounds[] = {
+	{ "x1", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL },
+	{ "x2", 0., 1.5, optm_BOUND_T_BS, optm_VAR_T_REAL },
+	{ "x3", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL },
+	{ "x4", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL }
+};
+
+static void solve(const char *criteria, const struct optm_VariableBound *bd)
+{
+	double x[n], value;
+	double sol[] = {0., 2., 1., 0.}, sol_bd[] = {0.5, 1.5, 1.5, 0.};
+	const double *s = bd ? sol_bd : sol;
+	struct lp_simplex_Options opts = {0};
+	int j, code, state;
+
+	opts.crash = 1;
+	state = lp_simplex_opt(obj, constraints, bd, m, n, criteria, 1000, &opts, x, &value, &code);
+	printf("%s (bounds = %d): error code = %u\n", criteria, bd != NULL, code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value - (bd ? 3.5 : 3.)) < 1e-8);
+	for (j = 0; j < n; j++)
+		assert(__lp_simplex_ABS__(x[j] - s[j]) < 1e-8);
+}
+
+int main(void)
+{
+	solve("", NULL);
+	solve("dantzig", NULL);
+	solve("bland", NULL);
+	solve("steepest", NULL);
+	solve("devex", NULL);
+	solve("", bounds);
+	solve("steepest", bounds);
+	return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: warm start from a basis saved in a basis file
+ *
+ *         min    -3 * x1 - 2 * x2 - 4 * x3 -     x4
+ *         s.t.        x1 +     x2 + 2 * x3 +     x4 <= 10
+ *                 2 * x1          +     x3 + 3 * x4 <= 12
+ *                     x1 +     x2                   >=  1
+ *                              x2 +     x3          =   4
+ *                0 <= x1 <= 3, x2, x3, x4 >= 0
+ *
+ * The optimal basis is written to a basis file and read back, and then
+ * used to solve the LP with a changed right hand side.
+ */
+#define m 4        /* number of constraints */
+#define n 4        /* number of variables   */
+#define file "test_lp_simplex_21.bas"
+
+double obj[] = {-3., -2., -4., -1.};
+double constraint_1_coef[] = {1., 1., 2., 1.};
+double constraint_2_coef[] = {2., 0., 1., 3.};
+double constraint_3_coef[] = {1., 1., 0., 0.};
+double constraint_4_coef[] = {0., 1., 1., 0.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "cap", constraint_1_coef, 10., optm_CONS_T_LE },
+	{ "", constraint_2_coef, 12., optm_CONS_T_LE },
+	{ "demand", constraint_3_coef,  1., optm_CONS_T_GE },
+	{ "", constraint_4_coef,  4., optm_CONS_T_EQ }
+};
+
+struct optm_VariableBound bounds[] = {
+	{ "x1", 0., 3., optm_BOUND_T_BS, optm_VAR_T_REAL },
+	{ "", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL },
+	{ "x3", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL },
+	{ "", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL }
+};
+
+/* Solve from `cstat` and `rstat` (or cold if `NULL`) with rhs 9 of the first row
+ */
+static double solve(const int *cstat, const int *rstat, double *x)
+{
+	struct lp_simplex_Solver *solver = lp_simplex_solver_create(obj, constraints, bounds, m, n);
+	double value;
+	int code;
+
+	assert(solver != NULL);
+	lp_simplex_solver_set_rhs(solver, 0, 9.);
+	if (cstat)
+		assert(lp_simplex_solver_set_basis(solver, cstat, rstat) == lp_simplex_EXIT_SUCCESS);
+	assert(lp_simplex_solver_solve(solver, 1000, x, &value, &code) == lp_simplex_EXIT_SUCCESS);
+	printf("warm = %d: error code = %u, value = %f\n", cstat != NULL, code, value);
+	lp_simplex_solver_free(solver);
+	return value;
+}
+
+int main(void)
+{
+	struct lp_simplex_Solver *solver;
+	int cstat[n], rstat[m], cstat2[n], rstat2[m], j, code;
+	int bad_cstat[] = {lp_simplex_BASIS_BASIC, lp_simplex_BASIS_BASIC, lp_simplex_BASIS_BASIC, lp_simplex_BASIS_BASIC};
+	int bad_rstat[] = {lp_simplex_BASIS_UPPER, lp_simplex_BASIS_UPPER, lp_simplex_BASIS_LOWER, lp_simplex_BASIS_LOWER};
+	double x[n], x2[n], value, value2;
+
+	solver = lp_simplex_solver_create(obj, constraints, bounds, m, n);
+	assert(solver != NULL);
+	assert(lp_simplex_solver_get_basis(solver, cstat, rstat) == lp_simplex_EXIT_FAILURE);
+	assert(lp_simplex_solver_solve(solver, 1000, x, &value, &code) == lp_simplex_EXIT_SUCCESS);
+	assert(lp_simplex_solver_get_basis(solver, cstat, rstat) == lp_simplex_EXIT_SUCCESS);
+	lp_simplex_solver_free(solver);
+
+	/* round trip through the basis file */
+	assert(lp_simplex_write_basis(file, constraints, bounds, m, n, cstat, rstat) == lp_simplex_EXIT_SUCCESS);
+	assert(lp_simplex_read_basis(file, constraints, bounds, m, n, cstat2, rstat2) == lp_simplex_EXIT_SUCCESS);
+	remove(file);
+	for (j = 0; j < n; j++)
+		assert(cstat[j] == cstat2[j]);
+	for (j = 0; j < m; j++)
+		assert(rstat[j] == rstat2[j]);
+
+	/* warm start agrees with the cold start */
+	value = solve(NULL, NULL, x);
+	value2 = solve(cstat2, rstat2, x2);
+	assert(__lp_simplex_ABS__(value - value2) < 1e-8);
+	for (j = 0; j < n; j++)
+		assert(__lp_simplex_ABS__(x[j] - x2[j]) < 1e-8);
+
+	/* a singular or infeasible basis falls back to phase 1 */
+	value2 = solve(bad_cstat, bad_rstat, x2);
+	assert(__lp_simplex_ABS__(value - value2) < 1e-8);
+
+	/* a basis needs m basic variables */
+	solver = lp_simplex_solver_create(obj, constraints, bounds, m, n);
+	bad_cstat[0] = lp_simplex_BASIS_LOWER;
+	assert(lp_simplex_solver_set_basis(solver, bad_cstat, bad_rstat) == lp_simplex_EXIT_FAILURE);
+	lp_simplex_solver_free(solver);
+	return 0;
+}
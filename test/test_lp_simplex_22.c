@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: one workspace reused by solves of different sizes
+ *
+ *         min        x1 + x2 + x3 + x4
+ *         s.t.       x1 + x2           >= 2
+ *                         x2 + x3       = 3
+ *                              x3 + x4 >= 1
+ *                    x1           - x4 <= 4
+ *                x1, x2 <= 1.5, x3, x4 >= 0
+ *
+ * and
+ *
+ *         max        x1 + 2 x2
+ *         s.t.       x1 +   x2 <= 4
+ *                    x1 + 3 x2 <= 6
+ *                x1, x2 >= 0
+ *
+ * Every solve gives the same solution with or without the workspace, and
+ * once the workspace held the largest LP it does not grow anymore
+ */
+double obj_1[] = {1., 1., 1., 1.};
+double constraint_1_coef[] = {1., 1., 0.,  0.};
+double constraint_2_coef[] = {0., 1., 1.,  0.};
+double constraint_3_coef[] = {0., 0., 1.,  1.};
+double constraint_4_coef[] = {1., 0., 0., -1.};
+
+struct optm_LinearConstraint constraints_1[] = {
+	{ "", constraint_1_coef, 2., optm_CONS_T_GE },
+	{ "", constraint_2_coef, 3., optm_CONS_T_EQ },
+	{ "", constraint_3_coef, 1., optm_CONS_T_GE },
+	{ "", constraint_4_coef, 4., optm_CONS_T_LE }
+};
+
+struct optm_VariableBound bounds_1[] = {
+	{ "x1", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL },
+	{ "x2", 0., 1.5, optm_BOUND_T_BS, optm_VAR_T_REAL },
+	{ "x3", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL },
+	{ "x4", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL }
+};
+
+double obj_2[] = {-1., -2.};
+double constraint_5_coef[] = {1., 1.};
+double constraint_6_coef[] = {1., 3.};
+
+struct optm_LinearConstraint constraints_2[] = {
+	{ "", constraint_5_coef, 4., optm_CONS_T_LE },
+	{ "", constraint_6_coef, 6., optm_CONS_T_LE }
+};
+
+const char *criteria[] = {"", "dantzig", "bland", "steepest", "devex", "partial", "multiple"};
+
+static void solve(struct lp_simplex_Workspace *ws, const char *crit, const int large, const int bounded)
+{
+	double x[4], x0[4], value, value0;
+	struct lp_simplex_Options opts = {0};
+	const struct optm_VariableBound *bd = bounded ? bounds_1 : NULL;
+	int j, code, state, n = large ? 4 : 2;
+
+	state = lp_simplex_opt(large ? obj_1 : obj_2, large ? constraints_1 : constraints_2, bd,
+			       large ? 4 : 2, n, crit, 1000, &opts, x0, &value0, &code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	opts.workspace = ws;
+	state = lp_simplex_opt(large ? obj_1 : obj_2, large ? constraints_1 : constraints_2, bd,
+			       large ? 4 : 2, n, crit, 1000, &opts, x, &value, &code);
+	printf("%s (n = %d, bounds = %d): error code = %u, value = %f\n", crit, n, bounded, code, value);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(value == value0);
+	for (j = 0; j < n; j++)
+		assert(x[j] == x0[j]);
+}
+
+static void solve_all(struct lp_simplex_Workspace *ws)
+{
+	int k;
+
+	for (k = 0; k < (int)(sizeof(criteria) / sizeof(criteria[0])); k++) {
+		solve(ws, criteria[k], 0, 0);
+		solve(ws, criteria[k], 1, 1);
+		solve(ws, criteria[k], 0, 0);
+		solve(ws, criteria[k], 1, 0);
+	}
+}
+
+int main(void)
+{
+	struct lp_simplex_Workspace *ws = lp_simplex_workspace_create();
+	size_t size;
+
+	assert(ws != NULL);
+	solve_all(ws);
+	size = lp_simplex_workspace_size(ws);
+	printf("workspace: %lu bytes\n", (unsigned long)size);
+	assert(size > 0);
+	solve_all(ws);
+	assert(lp_simplex_workspace_size(ws) == size);
+	lp_simplex_workspace_free(ws);
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+/* LP Example: allocator hooks and the arena
+ *
+ *         min        x1 + x2 + x3 + x4
+ *         s.t.       x1 + x2           >= 2
+ *                         x2 + x3       = 3
+ *                              x3 + x4 >= 1
+ *                    x1           - x4 <= 4
+ *                x1, x2 <= 1.5, x3, x4 >= 0
+ *
+ * The solution is (0.5, 1.5, 1.5, 0) and the optimal value is 3.5
+ */
+#define m 4        /* number of constraints */
+#define n 4        /* number of variables   */
+
+double obj[] = {1., 1., 1., 1.};
+double constraint_1_coef[] = {1., 1., 0.,  0.};
+double constraint_2_coef[] = {0., 1., 1.,  0.};
+double constraint_3_coef[] = {0., 0., 1.,  1.};
+double constraint_4_coef[] = {1., 0., 0., -1.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 2., optm_CONS_T_GE },
+	{ "", constraint_2_coef, 3., optm_CONS_T_EQ },
+	{ "", constraint_3_coef, 1., optm_CONS_T_GE },
+	{ "", constraint_4_coef, 4., optm_CONS_T_LE }
+};
+
+struct optm_VariableBound bounds[] = {
+	{ "x1", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL },
+	{ "x2", 0., 1.5, optm_BOUND_T_BS, optm_VAR_T_REAL },
+	{ "x3", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL },
+	{ "x4", 0., __lp_simplex_INF__, optm_BOUND_T_LO, optm_VAR_T_REAL }
+};
+
+/* Hooks counting the live blocks */
+static void *count_malloc(void *ctx, size_t size)
+{
+	(*(long *)ctx)++;
+	return malloc(size);
+}
+
+static void *count_realloc(void *ctx, void *ptr, size_t size)
+{
+	if (ptr == NULL)
+		(*(long *)ctx)++;
+	return realloc(ptr, size);
+}
+
+static void count_free(void *ctx, void *ptr)
+{
+	(*(long *)ctx)--;
+	free(ptr);
+}
+
+static void solve(const char *criteria, const int presolve)
+{
+	double x[n], value;
+	double sol[] = {0.5, 1.5, 1.5, 0.};
+	struct lp_simplex_Options opts = {0};
+	int j, code, state;
+
+	opts.presolve = presolve;
+	state = lp_simplex_opt(obj, constraints, bounds, m, n, criteria, 1000, &opts, x, &value, &code);
+	printf("%s (presolve = %d): error code = %u\n", criteria, presolve, code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value - 3.5) < 1e-8);
+	for (j = 0; j < n; j++)
+		assert(__lp_simplex_ABS__(x[j] - sol[j]) < 1e-8);
+}
+
+int main(void)
+{
+	static struct lp_simplex_Allocator hooks = { count_malloc, count_realloc, count_free, NULL, NULL, NULL };
+	struct lp_simplex_Arena *arena;
+	long live = 0;
+	size_t used;
+	void *p;
+
+	/* user hooks: every block is released, aligned ones included */
+	hooks.ctx = &live;
+	lp_simplex_set_allocator(&hooks);
+	solve("", 0);
+	solve("steepest", 1);
+	p = lp_simplex_malloc_aligned(100, 64);
+	assert(p != NULL && (size_t)p % 64 == 0);
+	lp_simplex_free_aligned(p);
+	assert(live == 0);
+	lp_simplex_set_allocator(NULL);
+
+	/* arena: a reset releases the whole solve, which is served the same way again */
+	arena = lp_simplex_arena_create(256);
+	assert(arena != NULL);
+	lp_simplex_arena_allocator(arena, &hooks);
+	lp_simplex_set_allocator(&hooks);
+	solve("devex", 1);
+	used = lp_simplex_arena_used(arena);
+	printf("arena: %lu bytes\n", (unsigned long)used);
+	assert(used > 0);
+	lp_simplex_arena_reset(arena);
+	assert(lp_simplex_arena_used(arena) == 0);
+	solve("devex", 1);
+	assert(lp_simplex_arena_used(arena) == used);
+	p = lp_simplex_malloc_aligned(100, 64);
+	assert(p != NULL && (size_t)p % 64 == 0);
+	lp_simplex_set_allocator(NULL);
+	lp_simplex_arena_free(arena);
+	return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L
+#endif
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <assert.h>
+
+/* LP Example: batch of random LPs solved by 1 to 8 threads
+ *
+ *         min        c^T x
+ *         s.t.       A x (<=, =, >=) b
+ *                0 <= x <= 4
+ *
+ * where A and c are random and b is chosen so that a point x0 is feasible.
+ * The last model has the extra constraint sum x <= -1 and is infeasible.
+ * Every batch gives the same results as solving the models one by one, and
+ * its elapsed time is printed for each number of threads (on machines with
+ * fewer cores the time does not drop).
+ */
+#define NMODEL	400
+#define M	12
+#define N	16
+
+static double wall_time(void)
+{
+#ifdef _WIN32
+	return (double)clock() / CLOCKS_PER_SEC;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+#endif
+}
+
+static struct lp_Model *random_model(const int infeasible)
+{
+	struct lp_Model *md = (struct lp_Model *)malloc(sizeof(struct lp_Model));
+	double x0[N];
+	int i, j;
+
+	md->m = infeasible ? M + 1 : M;
+	md->n = N;
+	md->objective = (double *)malloc(N * sizeof(double));
+	md->coefficients = (double *)malloc((M + 1) * N * sizeof(double));
+	md->constraints = (struct optm_LinearConstraint *)malloc((M + 1) * sizeof(struct optm_LinearConstraint));
+	md->bounds = (struct optm_VariableBound *)malloc(N * sizeof(struct optm_VariableBound));
+	for (j = 0; j < N; j++) {
+		md->objective[j] = rand() % 11 - 5;
+		md->bounds[j].name[0] = '\0';
+		md->bounds[j].lb = 0.;
+		md->bounds[j].ub = 4.;
+		md->bounds[j].b_type = optm_BOUND_T_BS;
+		md->bounds[j].v_type = optm_VAR_T_REAL;
+		x0[j] = rand() % 4;
+	}
+	for (i = 0; i < M + 1; i++) {
+		struct optm_LinearConstraint *cons = md->constraints + i;
+		double s = 0.;
+
+		cons->name[0] = '\0';
+		cons->coef = md->coefficients + i * N;
+		for (j = 0; j < N; j++) {
+			cons->coef[j] = i == M ? 1. : rand() % 3 ? 0. : rand() % 9 - 4;
+			s += cons->coef[j] * x0[j];
+		}
+		cons->type = i == M ? optm_CONS_T_LE : rand() % 3;
+		cons->rhs = i == M ? -1. : s + (cons->type == optm_CONS_T_LE ? rand() % 3 :
+				cons->type == optm_CONS_T_GE ? -(rand() % 3) : 0);
+	}
+	return md;
+}
+
+int main(void)
+{
+	static struct lp_Model *models[NMODEL];
+	static double xs[NMODEL][N], x0s[NMODEL][N], values[NMODEL], values0[NMODEL];
+	static double *x[NMODEL];
+	static int codes[NMODEL], codes0[NMODEL];
+	int nthreads, k, j, state;
+	double t;
+
+	srand(24);
+	for (k = 0; k < NMODEL; k++) {
+		models[k] = random_model(k == NMODEL - 1);
+		x[k] = xs[k];
+		lp_simplex_opt(models[k]->objective, models[k]->constraints, models[k]->bounds,
+			       models[k]->m, N, "", 1000, NULL, x0s[k], values0 + k, codes0 + k);
+	}
+	assert(codes0[NMODEL - 1] == lp_simplex_Infeasibility);
+	for (nthreads = 1; nthreads <= 8; nthreads *= 2) {
+		t = wall_time();
+		state = lp_simplex_batch(models, NMODEL, "", 1000, NULL, nthreads, x, values, codes);
+		printf("%d threads: %.4f s\n", nthreads, wall_time() - t);
+		assert(state == lp_simplex_EXIT_FAILURE);  /* the infeasible model */
+		for (k = 0; k < NMODEL; k++) {
+			assert(codes[k] == codes0[k]);
+			if (codes[k] != lp_simplex_Success)
+				continue;
+			assert(values[k] == values0[k]);
+			for (j = 0; j < N; j++)
+				assert(xs[k][j] == x0s[k][j]);
+		}
+	}
+	state = lp_simplex_batch(models, NMODEL - 1, "", 1000, NULL, 4, x, values, codes);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	for (k = 0; k < NMODEL; k++) {
+		free(models[k]->objective);
+		free(models[k]->coefficients);
+		free(models[k]->constraints);
+		free(models[k]->bounds);
+		free(models[k]);
+	}
+	return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: scenarios of right hand sides and objectives
+ *
+ *         max        3 x1 + 5 x2
+ *         s.t.         x1          <= b1
+ *                             2 x2 <= b2
+ *                      3 x1 + 2 x2 <= b3
+ *                x1, x2 >= 0
+ *
+ * b = (4, 12, 18) gives the solution (2, 6) and the optimal value 36.
+ * Scenarios change b (one of them infeasible) or the objective, and each
+ * must match a solve from scratch.
+ */
+#define m 3        /* number of constraints */
+#define n 2        /* number of variables   */
+#define NSCEN 5
+
+double obj[] = {-3., -5.};
+double constraint_1_coef[] = {1., 0.};
+double constraint_2_coef[] = {0., 2.};
+double constraint_3_coef[] = {3., 2.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 4., optm_CONS_T_LE },
+	{ "", constraint_2_coef, 12., optm_CONS_T_LE },
+	{ "", constraint_3_coef, 18., optm_CONS_T_LE }
+};
+
+double rhs[] = {
+	4., 12., 18.,
+	4., 12., 24.,
+	-1., 12., 18.,  /* infeasible */
+	2., 12., 18.,
+	4., 12., 18.
+};
+double values_rhs[] = {-36., -42., 0., -36., -36.};
+
+double objectives[] = {
+	-3., -5.,
+	-3., -1.,
+	-1., -5.,
+	-3., -5.,
+	-1., -1.
+};
+double values_obj[] = {-36., -15., -32., -36., -8.};
+
+/* Solve scenario k from scratch */
+static void check(const double *b, const double *c, const double v_expected, const double *x, const double v,
+		const int code)
+{
+	static struct optm_LinearConstraint cons[m];
+	double x0[n], v0;
+	int i, j, code0, state;
+
+	for (i = 0; i < m; i++) {
+		cons[i] = constraints[i];
+		cons[i].rhs = b ? b[i] : constraints[i].rhs;
+	}
+	state = lp_simplex_rev(c ? c : obj, cons, NULL, m, n, 1000, x0, &v0, &code0);
+	printf("scenario: error code = %u (%u)\n", code, code0);
+	assert(code == code0);
+	if (state != lp_simplex_EXIT_SUCCESS)
+		return;
+	printf("value = %f\n", v);
+	assert(__lp_simplex_ABS__(v - v_expected) < 1e-8);
+	assert(__lp_simplex_ABS__(v0 - v_expected) < 1e-8);
+	for (j = 0; j < n; j++)
+		assert(__lp_simplex_ABS__(x[j] - x0[j]) < 1e-8);
+}
+
+int main(void)
+{
+	double x[n * NSCEN], value[NSCEN];
+	int k, code[NSCEN], state;
+
+	state = lp_simplex_multi(obj, constraints, NULL, m, n, NSCEN, rhs, NULL, 1000, x, value, code);
+	assert(state == lp_simplex_EXIT_FAILURE);  /* the infeasible scenario */
+	assert(code[2] == lp_simplex_Infeasibility);
+	for (k = 0; k < NSCEN; k++)
+		check(rhs + k * m, NULL, values_rhs[k], x + k * n, value[k], code[k]);
+
+	state = lp_simplex_multi(obj, constraints, NULL, m, n, NSCEN, NULL, objectives, 1000, x, value, code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	for (k = 0; k < NSCEN; k++)
+		check(NULL, objectives + k * n, values_obj[k], x + k * n, value[k], code[k]);
+	return 0;
+}
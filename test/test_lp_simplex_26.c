@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: dual values and ranging
+ *
+ *         max        3 x1 + 5 x2
+ *         s.t.         x1          <= 4
+ *                             2 x2 <= 12
+ *                      3 x1 + 2 x2 <= 18
+ *                x1, x2 >= 0
+ *
+ * The solution is (2, 6). As a minimization of -3 x1 - 5 x2, the dual
+ * values are (0, -1.5, -1), the objective coefficients may move in
+ * [-7.5, 0] and (-INF, -2], and the right hand sides in [2, INF), [6, 18]
+ * and [12, 24] with the same basis.
+ */
+#define m 3        /* number of constraints */
+#define n 2        /* number of variables   */
+
+double obj[] = {-3., -5.};
+double constraint_1_coef[] = {1., 0.};
+double constraint_2_coef[] = {0., 2.};
+double constraint_3_coef[] = {3., 2.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 4., optm_CONS_T_LE },
+	{ "", constraint_2_coef, 12., optm_CONS_T_LE },
+	{ "", constraint_3_coef, 18., optm_CONS_T_LE }
+};
+
+double dual_expected[] = {0., -1.5, -1.};
+double objlo_expected[] = {-7.5, __lp_simplex_NINF__};
+double objup_expected[] = {0., -2.};
+double rhslo_expected[] = {2., 6., 12.};
+double rhsup_expected[] = {__lp_simplex_INF__, 18., 24.};
+
+static int same(const double a, const double b)
+{
+	if (a == __lp_simplex_INF__ || a == __lp_simplex_NINF__)
+		return a == b;
+	return __lp_simplex_ABS__(a - b) < 1e-8;
+}
+
+int main(void)
+{
+	double x[n], value, x2[n], value2;
+	double dual[m], redcost[n], objlo[n], objup[n], rhslo[m], rhsup[m];
+	struct lp_simplex_Ranging rg;
+	int i, j, code, state;
+
+	rg.dual = dual;
+	rg.redcost = redcost;
+	rg.objlo = objlo;
+	rg.objup = objup;
+	rg.rhslo = rhslo;
+	rg.rhsup = rhsup;
+	state = lp_simplex_ranging(obj, constraints, NULL, m, n, 1000, x, &value, &code, &rg);
+	printf("error code = %u, value = %f\n", code, value);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(same(value, -36.));
+	for (i = 0; i < m; i++) {
+		printf("row %d: dual = %f, rhs in [%g, %g]\n", i, dual[i], rhslo[i], rhsup[i]);
+		assert(same(dual[i], dual_expected[i]));
+		assert(same(rhslo[i], rhslo_expected[i]));
+		assert(same(rhsup[i], rhsup_expected[i]));
+	}
+	for (j = 0; j < n; j++) {
+		printf("column %d: reduced cost = %f, cost in [%g, %g]\n", j, redcost[j], objlo[j], objup[j]);
+		assert(same(redcost[j], 0.));
+		assert(same(objlo[j], objlo_expected[j]));
+		assert(same(objup[j], objup_expected[j]));
+	}
+
+	/* within the range of a rhs the value moves by the dual value */
+	for (i = 0; i < m; i++) {
+		double rhs = constraints[i].rhs, t = rhsup[i] < __lp_simplex_INF__ ? rhsup[i] : rhs + 1.;
+
+		constraints[i].rhs = t;
+		state = lp_simplex_rev(obj, constraints, NULL, m, n, 1000, x2, &value2, &code);
+		constraints[i].rhs = rhs;
+		assert(state == lp_simplex_EXIT_SUCCESS);
+		assert(same(value2, value + dual[i] * (t - rhs)));
+	}
+	/* within the range of a cost the solution stays */
+	for (j = 0; j < n; j++) {
+		double c = obj[j];
+
+		obj[j] = objlo[j] > __lp_simplex_NINF__ ? objlo[j] + 1e-3 : c - 1.;
+		state = lp_simplex_rev(obj, constraints, NULL, m, n, 1000, x2, &value2, &code);
+		obj[j] = c;
+		assert(state == lp_simplex_EXIT_SUCCESS);
+		assert(same(x2[0], x[0]) && same(x2[1], x[1]));
+	}
+	return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: parametric rhs and objective
+ *
+ *         max        3 x1 + 5 x2
+ *         s.t.         x1          <= 4
+ *                             2 x2 <= 12
+ *                      3 x1 + 2 x2 <= 18 + lam
+ *                x1, x2 >= 0
+ *
+ * As a minimization of -3 x1 - 5 x2, the value is -36 - lam up to lam = 6
+ * and stays -42 after. Moving the rhs down, the LP is infeasible below
+ * lam = -18. With the cost -3 - lam of x1 instead, the solution (2, 6)
+ * turns to (4, 3) at lam = 4.5. Every breakpoint and every midpoint agrees
+ * with a solve from scratch.
+ */
+#define m 3        /* number of constraints */
+#define n 2        /* number of variables   */
+#define MAXBP 16
+
+double obj[] = {-3., -5.};
+double constraint_1_coef[] = {1., 0.};
+double constraint_2_coef[] = {0., 2.};
+double constraint_3_coef[] = {3., 2.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 4., optm_CONS_T_LE },
+	{ "", constraint_2_coef, 12., optm_CONS_T_LE },
+	{ "", constraint_3_coef, 18., optm_CONS_T_LE }
+};
+
+static int same(const double a, const double b)
+{
+	return __lp_simplex_ABS__(a - b) < 1e-8;
+}
+
+/* Value of the LP at `lam` solved from scratch */
+static double cold(const double *drhs, const double *dobj, const double lam)
+{
+	double x[n], value, c[n];
+	struct optm_LinearConstraint cons[m];
+	int i, j, code, state;
+
+	for (j = 0; j < n; j++)
+		c[j] = obj[j] + (dobj ? lam * dobj[j] : 0.);
+	for (i = 0; i < m; i++) {
+		cons[i] = constraints[i];
+		cons[i].rhs += drhs ? lam * drhs[i] : 0.;
+	}
+	state = lp_simplex_rev(c, cons, NULL, m, n, 1000, x, &value, &code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	return value;
+}
+
+static void sweep(const double *drhs, const double *dobj, const double lmax,
+		  const int nbp_expected, const double *lambda_expected, const int code_expected)
+{
+	struct lp_simplex_Solver *solver = lp_simplex_solver_create(obj, constraints, NULL, m, n);
+	double lambda[MAXBP], value[MAXBP], x[n], v;
+	int cstat[MAXBP * n], rstat[MAXBP * m];
+	int k, nbp, code, state;
+
+	assert(solver != NULL);
+	state = lp_simplex_solver_parametric(solver, drhs, dobj, lmax, MAXBP, 1000,
+					     lambda, value, cstat, rstat, &nbp, &code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	printf("error code = %u, %d breakpoints\n", code, nbp);
+	assert(code == (unsigned)code_expected);
+	assert(nbp == nbp_expected);
+	for (k = 0; k < nbp; k++) {
+		printf("lam = %g: value = %f\n", lambda[k], value[k]);
+		assert(same(lambda[k], lambda_expected[k]));
+		assert(same(value[k], cold(drhs, dobj, lambda[k])));
+		/* linear between breakpoints */
+		if (k + 1 < nbp)
+			assert(same(cold(drhs, dobj, 0.5 * (lambda[k] + lambda[k + 1])),
+				    0.5 * (value[k] + value[k + 1])));
+	}
+	/* the data are back at lam = 0 and the solve starts from the last basis */
+	state = lp_simplex_solver_solve(solver, 1000, x, &v, &code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(same(v, -36.));
+	lp_simplex_solver_free(solver);
+}
+
+int main(void)
+{
+	double up[] = {0., 0., 1.};
+	double down[] = {0., 0., -1.};
+	double cost[] = {-1., 0.};
+	double lambda_up[] = {0., 6., 12.};
+	double lambda_down[] = {0., 6., 18.};
+	double lambda_cost[] = {0., 4.5, 10.};
+
+	sweep(up, NULL, 12., 3, lambda_up, lp_simplex_Success);
+	sweep(down, NULL, 30., 3, lambda_down, lp_simplex_Infeasibility);
+	sweep(NULL, cost, 10., 3, lambda_cost, lp_simplex_Success);
+	return 0;
+}
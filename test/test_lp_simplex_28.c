@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: rows and columns added to and deleted from a solver
+ *
+ *         min        - x1 - x2
+ *         s.t.         2 x1 +   x2 <= 4
+ *                        x1 + 2 x2 <= 4
+ *                x1, x2 >= 0
+ *
+ * has the solution (4/3, 4/3) and value -8/3. The cut x1 + x2 <= 2 gives
+ * the value -2, and a new column x3 (cost -3, one unit in each row) the
+ * value -6. Deleting the cut (then x1) gives -12, and the coefficient 2 of
+ * x3 in the first row gives -6 again.
+ */
+double obj[] = {-1., -1.};
+double constraint_1_coef[] = {2., 1.};
+double constraint_2_coef[] = {1., 2.};
+double cut_coef[] = {1., 1.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 4., optm_CONS_T_LE },
+	{ "", constraint_2_coef, 4., optm_CONS_T_LE }
+};
+
+struct optm_LinearConstraint cut[] = {
+	{ "", cut_coef, 2., optm_CONS_T_LE }
+};
+
+static void solve(struct lp_simplex_Solver *solver, const int n, const double expected)
+{
+	double x[3], value;
+	int j, code, state;
+
+	state = lp_simplex_solver_solve(solver, 1000, x, &value, &code);
+	printf("error code = %u, value = %f, x =", code, value);
+	for (j = 0; j < n; j++)
+		printf(" %f", x[j]);
+	printf("\n");
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value - expected) < 1e-8);
+}
+
+int main(void)
+{
+	struct lp_simplex_Solver *solver = lp_simplex_solver_create(obj, constraints, NULL, 2, 2);
+	double obj_3[] = {-3.};
+	double column_3[] = {1., 1., 1.};
+	int row = 2, col = 0;
+
+	assert(solver != NULL);
+	solve(solver, 2, -8. / 3.);
+	assert(lp_simplex_solver_add_rows(solver, 1, cut) == lp_simplex_EXIT_SUCCESS);
+	solve(solver, 2, -2.);
+	assert(lp_simplex_solver_add_cols(solver, 1, obj_3, column_3, NULL) == lp_simplex_EXIT_SUCCESS);
+	solve(solver, 3, -6.);
+	assert(lp_simplex_solver_del_rows(solver, 1, &row) == lp_simplex_EXIT_SUCCESS);
+	solve(solver, 3, -12.);
+	assert(lp_simplex_solver_del_cols(solver, 1, &col) == lp_simplex_EXIT_SUCCESS);
+	solve(solver, 2, -12.);
+	assert(lp_simplex_solver_set_coef(solver, 0, 1, 2.) == lp_simplex_EXIT_SUCCESS);
+	solve(solver, 2, -6.);
+	lp_simplex_solver_free(solver);
+	return 0;
+}
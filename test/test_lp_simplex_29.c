@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: MPS model read from an open stream
+ *
+ *         max    3 * x + 4 * y
+ *         s.t.       x + 2 * y <= 14
+ *                3 * x -     y >=  0
+ *                    x -     y <=  2
+ *                x, y >= 0
+ *
+ * The solution is (6., 4.) and the optimal value is 34. The same data are
+ * read from a path and from temporary streams, with "\n" or "\r\n" line
+ * ends and without the last line end.
+ */
+#define file "test_lp_simplex_29.mps"
+
+static void write_mps(FILE *f, const char *eol, const int last_eol)
+{
+	fprintf(f, "NAME          EXAMPLE%s", eol);
+	fprintf(f, "ROWS%s", eol);
+	fprintf(f, " N  COST%s", eol);
+	fprintf(f, " L  LIM1%s", eol);
+	fprintf(f, " G  LIM2%s", eol);
+	fprintf(f, " L  LIM3%s", eol);
+	fprintf(f, "COLUMNS%s", eol);
+	fprintf(f, "    %-8s  %-8s  %-12s   %-8s  %-12s%s", "X", "COST", "-3.", "LIM1", "1.", eol);
+	fprintf(f, "    %-8s  %-8s  %-12s   %-8s  %-12s%s", "X", "LIM2", "3.", "LIM3", "1.", eol);
+	fprintf(f, "    %-8s  %-8s  %-12s   %-8s  %-12s%s", "Y", "COST", "-4.", "LIM1", "2.", eol);
+	fprintf(f, "    %-8s  %-8s  %-12s   %-8s  %-12s%s", "Y", "LIM2", "-1.", "LIM3", "-1.", eol);
+	fprintf(f, "RHS%s", eol);
+	fprintf(f, "    %-8s  %-8s  %-12s   %-8s  %-12s%s", "RHS", "LIM1", "14.", "LIM3", "2.", eol);
+	fprintf(f, "ENDATA%s", last_eol ? eol : "");
+}
+
+static void check(struct lp_SparseModel *model)
+{
+	double x[2], value;
+	int code, state;
+
+	assert(model != NULL);
+	assert(model->m == 3 && model->n == 2 && model->nz == 6);
+	state = lp_simplex_sparse(model, "revised", 1000, NULL, x, &value, &code);
+	printf("error code = %u, value = %f\n", code, value);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value + 34.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[0] - 6.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[1] - 4.) < 1e-8);
+	lp_simplex_sparse_free(model);
+}
+
+static FILE *temp_mps(const char *eol, const int last_eol)
+{
+	FILE *f = tmpfile();
+
+	assert(f != NULL);
+	write_mps(f, eol, last_eol);
+	rewind(f);
+	return f;
+}
+
+int main(void)
+{
+	struct lp_Model *dense;
+	FILE *f;
+
+	f = fopen(file, "w");
+	assert(f != NULL);
+	write_mps(f, "\n", 1);
+	fclose(f);
+	check(lp_simplex_read_mps_sparse(file));
+	remove(file);
+
+	f = temp_mps("\n", 1);
+	check(lp_simplex_read_mps_sparse_stream(f));
+	fclose(f);
+	f = temp_mps("\r\n", 0);
+	check(lp_simplex_read_mps_sparse_stream(f));
+	fclose(f);
+
+	f = temp_mps("\r\n", 1);
+	dense = lp_simplex_read_mps_stream(f);
+	fclose(f);
+	assert(dense != NULL);
+	assert(dense->m == 3 && dense->n == 2);
+	assert(dense->constraints[2].rhs == 2. && dense->constraints[2].coef[1] == -1.);
+	assert(dense->objective[0] == -3. && dense->objective[1] == -4.);
+	lp_simplex_model_free(dense);
+	return 0;
+}
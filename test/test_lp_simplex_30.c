@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: MPS model with many named rows and columns
+ *
+ *         min        - x1 - x2 - ... - xN
+ *         s.t.       x1 + xk <= k + 1,  k = 2, ..., N
+ *                    x1      <= 1
+ *                x >= 0
+ *
+ * with the rows listed as R1, ..., RN and the columns C1, ..., CN in
+ * reverse order, C1 split into two blocks, and RHS entries of a row
+ * that does not exist. The solution is x1 = 0 and xk = k + 1 (k >= 2), and
+ * the optimal basis read back from a basis file is the same.
+ */
+#define N	400
+#define file "test_lp_simplex_30.bas"
+
+static void write_mps(FILE *f)
+{
+	char name[9], row[9];
+	int k;
+
+	fprintf(f, "NAME          MANY\n");
+	fprintf(f, "ROWS\n");
+	fprintf(f, " N  COST\n");
+	for (k = 1; k <= N; k++)
+		fprintf(f, " L  R%d\n", k);
+	fprintf(f, "COLUMNS\n");
+	fprintf(f, "    %-8s  %-8s  %-12s   %-8s  %-12s\n", "C1", "COST", "-1.", "R1", "1.");
+	for (k = N; k >= 2; k--) {
+		sprintf(name, "C%d", k);
+		sprintf(row, "R%d", k);
+		fprintf(f, "    %-8s  %-8s  %-12s   %-8s  %-12s\n", name, "COST", "-1.", row, "1.");
+		fprintf(f, "    %-8s  %-8s  %-12s\n", "C1", row, "1.");
+	}
+	fprintf(f, "RHS\n");
+	for (k = 1; k <= N; k++) {
+		sprintf(row, "R%d", k);
+		sprintf(name, "%d.", k + (k > 1));
+		fprintf(f, "    %-8s  %-8s  %-12s   %-8s  %-12s\n", "RHS", row, name, "NOROW", "7.");
+	}
+	fprintf(f, "ENDATA\n");
+}
+
+int main(void)
+{
+	static double x[N];
+	static int cstat[N], rstat[N], cstat2[N], rstat2[N];
+	struct lp_SparseModel *model;
+	struct lp_simplex_Solver *solver;
+	double value, expected = 0.;
+	int j, i, code, state;
+	FILE *f = tmpfile();
+
+	assert(f != NULL);
+	write_mps(f);
+	rewind(f);
+	model = lp_simplex_read_mps_sparse_stream(f);
+	fclose(f);
+	assert(model != NULL);
+	printf("m = %d, n = %d, nz = %d\n", model->m, model->n, model->nz);
+	assert(model->m == N && model->n == N && model->nz == 2 * N - 1);
+	assert(model->bounds[0].name[1] == '1' && model->bounds[1].name[1] == (N / 100 + '0'));
+	assert(model->constraints[N - 1].rhs == N + 1.);
+
+	solver = lp_simplex_solver_create_sparse(model);
+	assert(solver != NULL);
+	state = lp_simplex_solver_solve(solver, 10000, x, &value, &code);
+	printf("error code = %u, value = %f\n", code, value);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	for (j = 2; j <= N; j++)
+		expected -= j + 1.;
+	assert(__lp_simplex_ABS__(value - expected) < 1e-6);
+
+	/* the column of "C1" is the first one, and "C<k>" the (N - k + 2)-th */
+	assert(__lp_simplex_ABS__(x[0]) < 1e-9);
+	for (j = 1; j < N; j++)
+		assert(__lp_simplex_ABS__(x[j] - (N - j + 2.)) < 1e-9);
+
+	assert(lp_simplex_solver_get_basis(solver, cstat, rstat) == lp_simplex_EXIT_SUCCESS);
+	assert(lp_simplex_write_basis(file, model->constraints, model->bounds, N, N, cstat, rstat)
+	       == lp_simplex_EXIT_SUCCESS);
+	assert(lp_simplex_read_basis(file, model->constraints, model->bounds, N, N, cstat2, rstat2)
+	       == lp_simplex_EXIT_SUCCESS);
+	for (i = 0; i < N; i++) {
+		assert(cstat2[i] == cstat[i]);
+		assert(rstat2[i] == rstat[i]);
+	}
+	remove(file);
+	lp_simplex_solver_free(solver);
+	lp_simplex_sparse_free(model);
+	return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: crossed variable bounds
+ *
+ *         min        x1 + x2
+ *         s.t.       x1 + x2 <= 10
+ *                2 <= x1 <= 1   (or x1 <= -1),  x2 >= 0
+ *
+ * The bounds of x1 admit no value, so the LP is infeasible, also after the
+ * bounds of a solved revised solver are crossed by `lp_simplex_solver_set_bounds`.
+ *
+ * The same holds when a forcing row of the presolve reaches the crossed
+ * column first:
+ *
+ *         min        - 5 * x3 + 2 * x4 + 2 * x5 - x6
+ *         s.t.       x1 + 3 * x4 - 4 * x6 <= 4
+ *                    2 * x1 - x5          <= 5
+ *                -2 <= x3 <= -1,  x6 <= -1,  other x >= 0
+ */
+#define m 1        /* number of constraints */
+#define n 2        /* number of variables   */
+
+double obj[] = {1., 1.};
+double constraint_1_coef[] = {1., 1.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 10., optm_CONS_T_LE }
+};
+
+struct optm_VariableBound bounds_bs[] = {
+	{ "", 2., 1., optm_BOUND_T_BS },
+	{ "", 0., 0., optm_BOUND_T_LO }
+};
+
+struct optm_VariableBound bounds_up[] = {
+	{ "", 0., -1., optm_BOUND_T_UP },
+	{ "", 0., 0., optm_BOUND_T_LO }
+};
+
+#define m2 2
+#define n2 6
+
+double obj2[] = {0., 0., -5., 2., 2., -1.};
+double constraint2_1_coef[] = {1., 0., 0., 3., 0., -4.};
+double constraint2_2_coef[] = {2., 0., 0., 0., -1., 0.};
+
+struct optm_LinearConstraint constraints2[] = {
+	{ "", constraint2_1_coef, 4., optm_CONS_T_LE },
+	{ "", constraint2_2_coef, 5., optm_CONS_T_LE }
+};
+
+struct optm_VariableBound bounds2[] = {
+	{ "", 0., 0., optm_BOUND_T_LO },
+	{ "", 0., 0., optm_BOUND_T_LO },
+	{ "", -2., -1., optm_BOUND_T_BS },
+	{ "", 0., 0., optm_BOUND_T_LO },
+	{ "", 0., 0., optm_BOUND_T_LO },
+	{ "", 0., -1., optm_BOUND_T_UP }
+};
+
+static void solve(const struct optm_VariableBound *bounds, const char *criteria,
+		const int presolve, const int scaling)
+{
+	double x[n], value;
+	int code, state;
+	struct lp_simplex_Options opts = {0};
+
+	opts.presolve = presolve;
+	opts.scaling = scaling;
+	state = lp_simplex_opt(obj, constraints, bounds, m, n, criteria, 1000, &opts, x, &value, &code);
+	printf("\"%s\" (presolve = %d, scaling = %d): error code = %u\n", criteria, presolve, scaling, code);
+	assert(state == lp_simplex_EXIT_FAILURE);
+	assert(code == lp_simplex_Infeasibility);
+}
+
+static void solve_forcing(const char *criteria, const int presolve)
+{
+	double x[n2], value;
+	int code, state;
+	struct lp_simplex_Options opts = {0};
+
+	opts.presolve = presolve;
+	state = lp_simplex_opt(obj2, constraints2, bounds2, m2, n2, criteria, 1000, &opts, x, &value, &code);
+	printf("forcing row, \"%s\" (presolve = %d): error code = %u\n", criteria, presolve, code);
+	assert(state == lp_simplex_EXIT_FAILURE);
+	assert(code == lp_simplex_Infeasibility);
+}
+
+static void solve_handle(void)
+{
+	double x[n], value;
+	int code;
+	struct lp_simplex_Solver *solver = lp_simplex_solver_create(obj, constraints, NULL, m, n);
+
+	assert(solver != NULL);
+	assert(lp_simplex_solver_solve(solver, 1000, x, &value, &code) == lp_simplex_EXIT_SUCCESS);
+	lp_simplex_solver_set_bounds(solver, 0, 2., 1.);
+	assert(lp_simplex_solver_solve(solver, 1000, x, &value, &code) == lp_simplex_EXIT_FAILURE);
+	printf("solver (2 <= x1 <= 1): error code = %u\n", code);
+	assert(code == lp_simplex_Infeasibility);
+	lp_simplex_solver_set_bounds(solver, 0, 2., 3.);
+	assert(lp_simplex_solver_solve(solver, 1000, x, &value, &code) == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value - 2.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[0] - 2.) < 1e-8);
+	lp_simplex_solver_free(solver);
+}
+
+int main(void)
+{
+	const char *criteria[] = {"", "dantzig", "bland", "revised"};
+	int k;
+
+	solve_handle();
+	for (k = 0; k < 4; k++) {
+		solve(bounds_bs, criteria[k], 0, 0);
+		solve(bounds_up, criteria[k], 0, 0);
+		solve(bounds_bs, criteria[k], 1, 0);
+		solve(bounds_up, criteria[k], 1, 0);
+		solve(bounds_bs, criteria[k], 0, 1);
+		solve(bounds_up, criteria[k], 0, 1);
+		solve_forcing(criteria[k], 0);
+		solve_forcing(criteria[k], 1);
+	}
+	return 0;
+}
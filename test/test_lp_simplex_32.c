@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: reduced costs at the level of roundoff noise
+ *
+ *         min        - 1e-15 * x1 - x2 - 2 * x3
+ *         s.t.       - x1 + x2      <= 1
+ *                           x2 + x3 <= 2
+ *                                x3 <= 1
+ *                x >= 0
+ *
+ * The reduced cost of x1 is below the optimality tolerance, so x1 is not
+ * priced although its column is a ray. Every pricing rule, "partial" which
+ * scans x1 first included, reports x2 = x3 = 1 with value -3.
+ */
+#define m 3        /* number of constraints */
+#define n 3        /* number of variables   */
+
+double obj[] = {-1e-15, -1., -2.};
+double constraint_1_coef[] = {-1., 1., 0.};
+double constraint_2_coef[] = {0., 1., 1.};
+double constraint_3_coef[] = {0., 0., 1.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 1., optm_CONS_T_LE },
+	{ "", constraint_2_coef, 2., optm_CONS_T_LE },
+	{ "", constraint_3_coef, 1., optm_CONS_T_LE }
+};
+
+int main(void)
+{
+	const char *criteria[] = {"", "dantzig", "bland", "steepest", "devex", "partial", "multiple"};
+	double x[n], value;
+	int k, code, state;
+
+	for (k = 0; k < 7; k++) {
+		state = lp_simplex(obj, constraints, NULL, m, n, criteria[k], 1000, x, &value, &code);
+		printf("\"%s\": error code = %u\n", criteria[k], code);
+		assert(state == lp_simplex_EXIT_SUCCESS);
+		assert(__lp_simplex_ABS__(value + 3.) < 1e-8);
+		assert(__lp_simplex_ABS__(x[1] - 1.) < 1e-8);
+		assert(__lp_simplex_ABS__(x[2] - 1.) < 1e-8);
+	}
+	return 0;
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: revised simplex
+ *
+ *         min    2 * x1 + 3 * x2 +     x3
+ *         s.t.       x1 +     x2 +     x3 >= 4
+ *                    x1 -     x2          =  1
+ *                             x2 + 2 * x3 <= 6
+ *                x1, x2, x3 >= 0
+ *
+ * The solution is (1, 0, 3) and the optimal value is 5
+ */
+#define m 3        /* number of constraints */
+#define n 3        /* number of variables   */
+
+double obj[] = {2., 3., 1.};
+double constraint_1_coef[] = {1.,  1., 1.};
+double constraint_2_coef[] = {1., -1., 0.};
+double constraint_3_coef[] = {0.,  1., 2.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 4., optm_CONS_T_GE },
+	{ "", constraint_2_coef, 1., optm_CONS_T_EQ },
+	{ "", constraint_3_coef, 6., optm_CONS_T_LE }
+};
+
+int main(void)
+{
+	/* call simplex subroutine */
+	double x[n], value;
+	int code;
+	int state = lp_simplex(obj, constraints, NULL, m, n, "revised", 1000, x, &value, &code);
+
+	printf("Error code = %u\n", code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value - 5.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[0] - 1.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[1]) < 1e-8);
+	assert(__lp_simplex_ABS__(x[2] - 3.) < 1e-8);
+	return 0;
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <lp_simplex/lp_simplex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* LP Example: Beale's cycling example solved with different pricing rules
+ *
+ *         min    -3/4 * x1 + 20 * x2 - 0.5 * x3 + 6 * x4
+ *         s.t.   0.25 * x1 -  8 * x2 -       x3 + 9 * x4 <= 0
+ *                0.5  * x1 - 12 * x2 - 0.5 * x3 + 3 * x4 <= 0
+ *                                            x3          <= 1
+ *                x >= 0
+ *
+ * The solution is (1, 0, 1, 0) and the optimal value is -1.25
+ */
+#define m 3        /* number of constraints */
+#define n 4        /* number of variables   */
+
+double obj[] = {-3./4., 20., -0.5, 6.};
+double constraint_1_coef[] = {0.25, -8., -1., 9.};
+double constraint_2_coef[] = {0.5, -12., -0.5, 3.};
+double constraint_3_coef[] = {0., 0., 1., 0.};
+
+struct optm_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef,  0., optm_CONS_T_LE },
+	{ "", constraint_2_coef,  0., optm_CONS_T_LE },
+	{ "", constraint_3_coef,  1., optm_CONS_T_LE }
+};
+
+static void solve(const char *criteria)
+{
+	double x[n], value;
+	int code;
+	int state = lp_simplex(obj, constraints, NULL, m, n, criteria, 1000, x, &value, &code);
+
+	printf("%s: error code = %u\n", criteria, code);
+	assert(state == lp_simplex_EXIT_SUCCESS);
+	assert(__lp_simplex_ABS__(value + 1.25) < 1e-8);
+	assert(__lp_simplex_ABS__(x[0] - 1.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[1]) < 1e-8);
+	assert(__lp_simplex_ABS__(x[2] - 1.) < 1e-8);
+	assert(__lp_simplex_ABS__(x[3]) < 1e-8);
+}
+
+int main(void)
+{
+	solve("steepest");
+	solve("devex");
+	solve("partial");
+	solve("multiple");
+	return 0;
+}